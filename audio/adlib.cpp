@@ -947,6 +947,8 @@ public:
 	MidiChannel *getPercussionChannel() override { return &_percussion; } // Percussion partially supported
 
 	void setTimerCallback(void *timerParam, Common::TimerManager::TimerProc timerProc) override;
+	bool setRecordStream(Common::WriteStream *stream) override { return _opl && _opl->setRecordStream(stream); }
+	int64 getRecordedSize() override { return _opl ? _opl->getRecordedSize() : 0; }
 
 private:
 	bool _scummSmallHeader; // FIXME: This flag controls a special mode for SCUMM V3 games
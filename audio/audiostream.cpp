@@ -38,6 +38,27 @@
 
 namespace Audio {
 
+int AudioStream::readBufferFloat(float *buffer, const int numSamples) {
+	int16 samples[512];
+	int total = 0;
+
+	while (total < numSamples) {
+		const int request = MIN<int>(numSamples - total, ARRAYSIZE(samples));
+		const int read = readBuffer(samples, request);
+		if (read <= 0)
+			return total ? total : read;
+
+		for (int i = 0; i < read; i++)
+			buffer[total + i] = samples[i] * (1.0f / 32768.0f);
+		total += read;
+
+		if (read < request)
+			break;
+	}
+
+	return total;
+}
+
 struct StreamFileFormat {
 	/** Decodername */
 	const char *decoderName;
@@ -69,6 +69,19 @@ public:
 	 */
 	virtual int readBuffer(int16 *buffer, const int numSamples) = 0;
 
+	/**
+	 * Fill the given buffer with up to @p numSamples float samples in the
+	 * range [-1, 1], laid out like in readBuffer().
+	 *
+	 * This is used by the mixer when the backend requested float output.
+	 * The default implementation converts the output of readBuffer(), streams
+	 * which decode to a higher precision can override it to avoid quantizing
+	 * their samples to 16 bits.
+	 *
+	 * @return The actual number of samples read, or -1 if a critical error occurred.
+	 */
+	virtual int readBufferFloat(float *buffer, const int numSamples);
+
 	/** Check whether this is a stereo stream. */
 	virtual bool isStereo() const = 0;
 
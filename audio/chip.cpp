@@ -97,7 +97,8 @@ EmulatedChip::EmulatedChip() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) { }
+	_handle(new Audio::SoundHandle()),
+	_recordStream(nullptr) { }
 
 EmulatedChip::~EmulatedChip() {
 	// Stop callbacks, just in case. If it's still playing at this
@@ -121,6 +122,14 @@ int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
 
 		generateSamples(buffer, step * stereoFactor);
 
+		if (_recordStream) {
+			Common::StackLock lock(_recordMutex);
+			if (_recordStream) {
+				for (int i = 0; i < step * stereoFactor; i++)
+					_recordStream->writeSint16LE(buffer[i]);
+			}
+		}
+
 		_nextTick -= step << FIXP_SHIFT;
 		if (!(_nextTick >> FIXP_SHIFT)) {
 			if (_callback && _callback->isValid())
@@ -136,6 +145,23 @@ int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
 	return numSamples;
 }
 
+bool EmulatedChip::setRecordStream(Common::WriteStream *stream) {
+	Common::StackLock lock(_recordMutex);
+
+	_recordStream = stream;
+	if (_recordStream) {
+		_recordStream->writeUint32LE(getRate());
+		_recordStream->writeByte(isStereo() ? 2 : 1);
+	}
+
+	return true;
+}
+
+int64 EmulatedChip::getRecordedSize() {
+	Common::StackLock lock(_recordMutex);
+	return _recordStream ? _recordStream->pos() : 0;
+}
+
 int EmulatedChip::getRate() const {
 	return g_system->getMixer()->getOutputRate();
 }
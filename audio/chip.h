@@ -23,7 +23,9 @@
 #define AUDIO_CHIP_H
 
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
+#include "common/stream.h"
 
 #include "audio/audiostream.h"
 
@@ -55,6 +57,20 @@ public:
 	 */
 	virtual void setCallbackFrequency(int timerFrequency) = 0;
 
+	/**
+	 * Copy the output of an emulated chip to the given stream. See
+	 * MidiDriver::setRecordStream() for the format.
+	 *
+	 * @return false if the chip does not support recording.
+	 */
+	virtual bool setRecordStream(Common::WriteStream *stream) { return false; }
+
+	/**
+	 * Return the number of bytes written to the record stream so far. See
+	 * MidiDriver::getRecordedSize().
+	 */
+	virtual int64 getRecordedSize() { return 0; }
+
 protected:
 	/**
 	 * Start the callbacks.
@@ -119,6 +135,8 @@ public:
 
 	// Chip API
 	void setCallbackFrequency(int timerFrequency) override;
+	bool setRecordStream(Common::WriteStream *stream) override;
+	int64 getRecordedSize() override;
 
 	// AudioStream API
 	int readBuffer(int16 *buffer, const int numSamples) override;
@@ -149,6 +167,9 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+
+	Common::WriteStream *_recordStream;
+	Common::Mutex _recordMutex;
 };
 
 } // End of namespace Audio
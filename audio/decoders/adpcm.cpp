@@ -57,6 +57,17 @@ void ADPCMStream::reset() {
 	_blockPos[0] = _blockPos[1] = _blockAlign; // To make sure first header is read
 }
 
+uint32 ADPCMStream::readData(byte *data, uint32 maxBytes) {
+	if (_stream->eos())
+		return 0;
+
+	const int32 pos = _stream->pos();
+	if (pos >= _endpos)
+		return 0;
+
+	return _stream->read(data, MIN<uint32>(maxBytes, _endpos - pos));
+}
+
 bool ADPCMStream::rewind() {
 	// TODO: Error checking.
 	reset();
@@ -69,20 +80,30 @@ bool ADPCMStream::rewind() {
 
 
 int Oki_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+	int samples = 0;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeOKI((data >> 4) & 0x0f);
-			_decodedSamples[1] = decodeOKI((data >> 0) & 0x0f);
-			_decodedSampleCount = 2;
-		}
+	if (_decodedSampleCount && numSamples > 0) {
+		buffer[samples++] = _decodedSample;
+		_decodedSampleCount = 0;
+	}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+	byte data[kReadChunkSize];
+	while (samples < numSamples) {
+		const uint32 size = readData(data, MIN<uint32>((numSamples - samples + 1) / 2, sizeof(data)));
+		if (!size)
+			break;
+
+		for (uint32 i = 0; i < size; i++) {
+			buffer[samples++] = decodeOKI((data[i] >> 4) & 0x0f);
+			const int16 sample = decodeOKI((data[i] >> 0) & 0x0f);
+
+			if (samples < numSamples) {
+				buffer[samples++] = sample;
+			} else {
+				_decodedSample = sample;
+				_decodedSampleCount = 1;
+			}
+		}
 	}
 
 	return samples;
@@ -122,7 +143,7 @@ int16 Oki_ADPCMStream::decodeOKI(byte code) {
 
 int XA_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	int samples;
-	byte *data = new byte[128];
+	byte data[128];
 
 	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
 		if (_decodedSampleCount == 0) {
@@ -143,7 +164,6 @@ int XA_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 		_decodedSampleCount--;
 	}
 
-	delete[] data;
 	return samples;
 }
 
@@ -220,21 +240,53 @@ void XA_ADPCMStream::decodeXA(const byte *src) {
 #pragma mark -
 
 
+// Decode one IMA ADPCM nibble. The block decoders use this directly, so they
+// can keep the channel status in local variables.
+static inline int16 decodeIMANibble(int32 &last, int32 &stepIndex, byte code) {
+	int32 E = (2 * (code & 0x7) + 1) * Ima_ADPCMStream::_imaTable[stepIndex] / 8;
+	int32 diff = (code & 0x08) ? -E : E;
+	last = CLIP<int32>(last + diff, -32768, 32767);
+
+	stepIndex += ADPCMStream::_stepAdjustTable[code];
+	stepIndex = CLIP<int32>(stepIndex, 0, ARRAYSIZE(Ima_ADPCMStream::_imaTable) - 1);
+
+	return last;
+}
+
 int DVI_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+	const int secondChannel = (_channels == 2) ? 1 : 0;
+	int samples = 0;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeIMA((data >> 4) & 0x0f, 0);
-			_decodedSamples[1] = decodeIMA((data >> 0) & 0x0f, _channels == 2 ? 1 : 0);
-			_decodedSampleCount = 2;
+	if (_decodedSampleCount && numSamples > 0) {
+		buffer[samples++] = _decodedSample;
+		_decodedSampleCount = 0;
+	}
+
+	byte data[kReadChunkSize];
+	while (samples < numSamples) {
+		const uint32 size = readData(data, MIN<uint32>((numSamples - samples + 1) / 2, sizeof(data)));
+		if (!size)
+			break;
+
+		int32 last[2] = { _status.ima_ch[0].last, _status.ima_ch[1].last };
+		int32 stepIndex[2] = { _status.ima_ch[0].stepIndex, _status.ima_ch[1].stepIndex };
+
+		for (uint32 i = 0; i < size; i++) {
+			buffer[samples++] = decodeIMANibble(last[0], stepIndex[0], (data[i] >> 4) & 0x0f);
+			const int16 sample = decodeIMANibble(last[secondChannel], stepIndex[secondChannel], (data[i] >> 0) & 0x0f);
+
+			if (samples < numSamples) {
+				buffer[samples++] = sample;
+			} else {
+				_decodedSample = sample;
+				_decodedSampleCount = 1;
+			}
 		}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+		for (int i = 0; i < 2; i++) {
+			_status.ima_ch[i].last = last[i];
+			_status.ima_ch[i].stepIndex = stepIndex[i];
+		}
 	}
 
 	return samples;
@@ -310,43 +362,66 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 #pragma mark -
 
 
-int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	// Need to write at least one sample per channel
-	assert((numSamples % _channels) == 0);
+bool MSIma_ADPCMStream::decodeBlock() {
+	_blockSamplePos = _blockSampleCount = 0;
 
-	int samples = 0;
+	const uint32 size = readData(_blockData.data(), _blockAlign);
+	const uint32 headerSize = _channels * 4;
+	if (size < headerSize)
+		return size != 0;
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
-			for (int i = 0; i < _channels; i++) {
-				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
-			}
+	const byte *data = _blockData.data();
+	for (int i = 0; i < _channels; i++) {
+		// read block header
+		_status.ima_ch[i].last = (int16)READ_LE_UINT16(data);
+		_status.ima_ch[i].stepIndex = (int16)READ_LE_UINT16(data + 2);
+		data += 4;
+	}
 
-			_blockPos[0] = _channels * 4;
-		}
+	// The block encodes four bytes per channel at a time, which are
+	// decoded one channel after the other
+	const uint32 groups = (size - headerSize) / headerSize;
+	int16 *out = _blockSamples.data();
 
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
+	for (int i = 0; i < _channels; i++) {
+		int32 last = _status.ima_ch[i].last;
+		int32 stepIndex = _status.ima_ch[i].stepIndex;
+		const byte *src = data + i * 4;
+		int16 *dst = out + i;
+
+		for (uint32 group = 0; group < groups; group++) {
 			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
+				const byte code = src[j];
+				dst[0] = decodeIMANibble(last, stepIndex, code & 0x0f);
+				dst[_channels] = decodeIMANibble(last, stepIndex, (code >> 4) & 0x0f);
+				dst += _channels * 2;
 			}
+
+			src += headerSize;
 		}
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
-			}
+		_status.ima_ch[i].last = last;
+		_status.ima_ch[i].stepIndex = stepIndex;
+	}
 
-			samples += _channels;
-		}
+	_blockSampleCount = groups * _channels * 8;
+	return true;
+}
+
+int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	// Need to write at least one sample per channel
+	assert((numSamples % _channels) == 0);
+
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount && !decodeBlock())
+			break;
+
+		const uint32 count = MIN<uint32>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -387,46 +462,59 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 	return (int16)predictor;
 }
 
-int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+bool MS_ADPCMStream::decodeBlock() {
+	_blockSamplePos = _blockSampleCount = 0;
+
+	const uint32 size = readData(_blockData.data(), _blockAlign);
+	const uint32 headerSize = _channels * 7;
+	if (size < headerSize)
+		return size != 0;
+
+	// read block header
+	const byte *data = _blockData.data();
+	int16 *out = _blockSamples.data();
 	int i;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
+	for (i = 0; i < _channels; i++) {
+		_status.ch[i].predictor = CLIP(data[i], (byte)0, (byte)6);
+		_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
+		_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
+	}
+	data += _channels;
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, data += 2)
+		_status.ch[i].delta = (int16)READ_LE_UINT16(data);
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, data += 2)
+		_status.ch[i].sample1 = (int16)READ_LE_UINT16(data);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, data += 2)
+		*out++ = _status.ch[i].sample2 = (int16)READ_LE_UINT16(data);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
+	for (i = 0; i < _channels; i++)
+		*out++ = _status.ch[i].sample1;
 
-				_blockPos[0] = _channels * 7;
-			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
-			}
-			_decodedSampleIndex = 0;
-		}
+	ADPCMChannelStatus *second = &_status.ch[_channels - 1];
+	for (const byte *end = _blockData.data() + size; data < end; data++) {
+		*out++ = decodeMS(&_status.ch[0], (*data >> 4) & 0x0f);
+		*out++ = decodeMS(second, *data & 0x0f);
+	}
 
-		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
-		_decodedSampleCount--;
+	_blockSampleCount = out - _blockSamples.data();
+	return true;
+}
+
+int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount && !decodeBlock())
+			break;
+
+		const uint32 count = MIN<uint32>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -546,15 +634,7 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 };
 
 int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
-	int32 E = (2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex] / 8;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
-
-	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
-
-	return samp;
+	return decodeIMANibble(_status.ima_ch[channel].last, _status.ima_ch[channel].stepIndex, code);
 }
 
 SeekableAudioStream *makeADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
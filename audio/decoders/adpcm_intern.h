@@ -31,6 +31,7 @@
 #define AUDIO_ADPCM_INTERN_H
 
 #include "audio/audiostream.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/ptr.h"
 #include "common/stream.h"
@@ -59,6 +60,19 @@ protected:
 
 	virtual void reset();
 
+	/**
+	 * Read up to maxBytes bytes of ADPCM data in one go, without reading
+	 * past the end of the sound.
+	 *
+	 * @return The number of bytes read.
+	 */
+	uint32 readData(byte *data, uint32 maxBytes);
+
+	/** Size of the chunks read by the decoders working byte by byte. */
+	enum {
+		kReadChunkSize = 256
+	};
+
 public:
 	ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
@@ -93,8 +107,10 @@ protected:
 	int16 decodeOKI(byte);
 
 private:
+	// The second sample of the last byte, if the caller asked for an odd
+	// number of samples
 	uint8 _decodedSampleCount;
-	int16 _decodedSamples[2];
+	int16 _decodedSample;
 };
 
 class XA_ADPCMStream : public ADPCMStream {
@@ -139,8 +155,10 @@ public:
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 private:
+	// The second sample of the last byte, if the caller asked for an odd
+	// number of samples
 	uint8 _decodedSampleCount;
-	int16 _decodedSamples[2];
+	int16 _decodedSample;
 };
 
 class Apple_ADPCMStream : public Ima_ADPCMStream {
@@ -182,21 +200,28 @@ public:
 		if (blockAlign % (_channels * 4))
 			error("MSIma_ADPCMStream(): invalid blockAlign");
 
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockData.resize(blockAlign);
+		_blockSamples.resize(blockAlign * 2);
+		_blockSamplePos = _blockSampleCount = 0;
 	}
 
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && _blockSamplePos == _blockSampleCount; }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 	void reset() {
 		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockSamplePos = _blockSampleCount = 0;
 	}
 
 private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	bool decodeBlock();
+
+	// Whole blocks are decoded at once
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _blockSamples;
+	uint32 _blockSamplePos;
+	uint32 _blockSampleCount;
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -218,6 +243,7 @@ protected:
 	void reset() {
 		ADPCMStream::reset();
 		memset(&_status, 0, sizeof(_status));
+		_blockSamplePos = _blockSampleCount = 0;
 	}
 
 public:
@@ -226,11 +252,12 @@ public:
 		if (blockAlign == 0)
 			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
 		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
-		_decodedSampleIndex = 0;
+		_blockData.resize(blockAlign);
+		_blockSamples.resize(blockAlign * 2);
+		_blockSamplePos = _blockSampleCount = 0;
 	}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && _blockSamplePos == _blockSampleCount; }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
@@ -238,9 +265,13 @@ protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
 
 private:
-	uint8 _decodedSampleCount;
-	uint8 _decodedSampleIndex;
-	int16 _decodedSamples[4];
+	bool decodeBlock();
+
+	// Whole blocks are decoded at once
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _blockSamples;
+	uint32 _blockSamplePos;
+	uint32 _blockSampleCount;
 };
 
 // Duck DK3 IMA ADPCM Decoder
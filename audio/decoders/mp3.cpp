@@ -23,6 +23,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -64,7 +65,8 @@ protected:
 	void readHeader(Common::ReadStream &stream);
 	void deinitStream();
 
-	int fillBuffer(Common::ReadStream &stream, int16 *buffer, const int numSamples);
+	template<typename T>
+	int fillBuffer(Common::ReadStream &stream, T *buffer, const int numSamples);
 
 	enum State {
 		MP3_STATE_INIT,	// Need to init the decoder
@@ -98,6 +100,7 @@ public:
 	               DisposeAfterUse::Flag dispose);
 
 	int readBuffer(int16 *buffer, const int numSamples) override;
+	int readBufferFloat(float *buffer, const int numSamples) override;
 	bool seek(const Timestamp &where) override;
 	Timestamp getLength() const override { return _length; }
 
@@ -106,6 +109,22 @@ protected:
 
 	Timestamp _length;
 
+	enum {
+		// Number of frames between two seek table entries
+		SEEK_TABLE_INTERVAL = 16
+	};
+
+	struct SeekPoint {
+		uint32 offset;      ///< Position of the frame header in _inStream
+		mad_timer_t time;   ///< Playback time at the start of the frame
+	};
+
+	// Frame positions collected while scanning the stream length, so
+	// seeking does not have to walk the headers from the start
+	Common::Array<SeekPoint> _seekTable;
+
+	const SeekPoint *findSeekPoint(const mad_timer_t &destination) const;
+
 private:
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
 };
@@ -303,16 +322,27 @@ static inline int scaleSample(mad_fixed_t sample) {
 	return sample >> (MAD_F_FRACBITS + 1 - 16);
 }
 
-int BaseMP3Stream::fillBuffer(Common::ReadStream &stream, int16 *buffer, const int numSamples) {
+static inline void storeSample(int16 *buffer, mad_fixed_t sample) {
+	*buffer = (int16)scaleSample(sample);
+}
+
+static inline void storeSample(float *buffer, mad_fixed_t sample) {
+	// clip and scale like scaleSample(), but keep the full precision
+	sample = CLIP<mad_fixed_t>(sample, -MAD_F_ONE, MAD_F_ONE - 1);
+	*buffer = sample * (1.0f / (2 * MAD_F_ONE));
+}
+
+template<typename T>
+int BaseMP3Stream::fillBuffer(Common::ReadStream &stream, T *buffer, const int numSamples) {
 	int samples = 0;
 	// Keep going as long as we have input available
 	while (samples < numSamples && _state != MP3_STATE_EOS) {
 		const int len = MIN(numSamples, samples + (int)(_synth.pcm.length - _posInFrame) * MAD_NCHANNELS(&_frame.header));
 		while (samples < len) {
-			*buffer++ = (int16)scaleSample(_synth.pcm.samples[0][_posInFrame]);
+			storeSample(buffer++, _synth.pcm.samples[0][_posInFrame]);
 			samples++;
 			if (MAD_NCHANNELS(&_frame.header) == 2) {
-				*buffer++ = (int16)scaleSample(_synth.pcm.samples[1][_posInFrame]);
+				storeSample(buffer++, _synth.pcm.samples[1][_posInFrame]);
 				samples++;
 			}
 			_posInFrame++;
@@ -336,10 +366,20 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream and build the seek table
+	uint32 frame = 0;
+	while (_state != MP3_STATE_EOS) {
+		const mad_timer_t frameStart = _curTime;
 		readHeader(*_inStream);
 
+		if (_state != MP3_STATE_EOS && (frame++ % SEEK_TABLE_INTERVAL) == 0) {
+			SeekPoint point;
+			point.offset = _inStream->pos() - (_stream.bufend - _stream.this_frame);
+			point.time = frameStart;
+			_seekTable.push_back(point);
+		}
+	}
+
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
 	// We need to assure this, since else we might trigger an assertion in Timestamp
@@ -363,6 +403,10 @@ int MP3Stream::readBuffer(int16 *buffer, const int numSamples) {
 	return fillBuffer(*_inStream, buffer, numSamples);
 }
 
+int MP3Stream::readBufferFloat(float *buffer, const int numSamples) {
+	return fillBuffer(*_inStream, buffer, numSamples);
+}
+
 bool MP3Stream::seek(const Timestamp &where) {
 	if (where == _length) {
 		_state = MP3_STATE_EOS;
@@ -376,7 +420,15 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
+	const bool restart = _state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0;
+	const SeekPoint *point = findSeekPoint(destination);
+
+	if (point && (restart || mad_timer_compare(point->time, _curTime) > 0)) {
+		// Resume at the closest indexed frame instead of the current position
+		_inStream->seek(point->offset);
+		initStream(*_inStream);
+		_curTime = point->time;
+	} else if (restart) {
 		_inStream->seek(0);
 		initStream(*_inStream);
 	}
@@ -389,6 +441,20 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
+const MP3Stream::SeekPoint *MP3Stream::findSeekPoint(const mad_timer_t &destination) const {
+	// Binary search for the last frame starting at or before the destination
+	uint lo = 0, hi = _seekTable.size();
+	while (lo < hi) {
+		const uint mid = (lo + hi) / 2;
+		if (mad_timer_compare(_seekTable[mid].time, destination) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo ? &_seekTable[lo - 1] : nullptr;
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
@@ -28,6 +28,7 @@
 
 #ifdef USE_VORBIS
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
@@ -102,6 +103,15 @@ protected:
 	const int16 *_bufferEnd;
 	const int16 *_pos;
 
+	struct SeekPoint {
+		ogg_int64_t offset;	///< Raw stream position of the next page to decode
+		ogg_int64_t sample;	///< Sample pair position when the offset was recorded
+	};
+
+	// Seek points recorded about once per second while decoding, used to
+	// skip the bisection search of ov_pcm_seek for positions already played
+	Common::Array<SeekPoint> _seekTable;
+
 public:
 	// startTime / duration are in milliseconds
 	VorbisStream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose);
@@ -117,6 +127,10 @@ public:
 	Timestamp getLength() const override { return _length; }
 protected:
 	bool refill();
+	long decode(char *buffer, int length);
+	bool seekIndexed(ogg_int64_t sample);
+	bool skipTo(ogg_int64_t sample);
+	void updateSeekTable();
 };
 
 VorbisStream::VorbisStream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -169,7 +183,11 @@ int VorbisStream::readBuffer(int16 *buffer, const int numSamples) {
 bool VorbisStream::seek(const Timestamp &where) {
 	// Vorbisfile uses the sample pair number, thus we always use "false" for the isStereo parameter
 	// of the convertTimeToStreamPos helper.
-	int res = ov_pcm_seek(&_ovFile, convertTimeToStreamPos(where, getRate(), false).totalNumberOfFrames());
+	const ogg_int64_t sample = convertTimeToStreamPos(where, getRate(), false).totalNumberOfFrames();
+	if (seekIndexed(sample))
+		return refill();
+
+	int res = ov_pcm_seek(&_ovFile, sample);
 	if (res) {
 		warning("Error seeking in Vorbis stream (%d)", res);
 		_pos = _bufferEnd;
@@ -179,35 +197,97 @@ bool VorbisStream::seek(const Timestamp &where) {
 	return refill();
 }
 
-bool VorbisStream::refill() {
-	// Read the samples
-	uint len_left = sizeof(_buffer);
-	char *read_pos = (char *)_buffer;
+bool VorbisStream::seekIndexed(ogg_int64_t sample) {
+	// Decoding ahead beats the bisection of ov_pcm_seek only over a short
+	// distance, so allow skipping at most a few seek table intervals
+	const ogg_int64_t maxSkip = 3 * _rate;
 
-	while (len_left > 0) {
-		long result;
+	const ogg_int64_t current = ov_pcm_tell(&_ovFile);
+	if (current >= 0 && current <= sample && sample - current <= maxSkip)
+		return skipTo(sample);
 
+	// Find the first seek point past the requested sample. Resuming at the
+	// point before it may still land slightly past its own sample, so go
+	// two points back, which is safely before the destination.
+	uint next = 0;
+	while (next < _seekTable.size() && _seekTable[next].sample <= sample)
+		next++;
+
+	if (next < 2 || sample - _seekTable[next - 2].sample > maxSkip)
+		return false;
+
+	if (ov_raw_seek(&_ovFile, _seekTable[next - 2].offset))
+		return false;
+
+	// If the page turned out to start past the destination let
+	// ov_pcm_seek handle it instead
+	if (ov_pcm_tell(&_ovFile) > sample)
+		return false;
+
+	return skipTo(sample);
+}
+
+bool VorbisStream::skipTo(ogg_int64_t sample) {
+	const int channels = ov_info(&_ovFile, -1)->channels;
+
+	ogg_int64_t position;
+	while ((position = ov_pcm_tell(&_ovFile)) < sample) {
+		const int frames = (int)MIN<ogg_int64_t>(sample - position, ARRAYSIZE(_buffer) / channels);
+		const long result = decode((char *)_buffer, frames * channels * 2);
+		if (result <= 0 && result != OV_HOLE)
+			return false;
+	}
+
+	return position == sample;
+}
+
+void VorbisStream::updateSeekTable() {
+	const ogg_int64_t sample = ov_pcm_tell(&_ovFile);
+	if (sample < 0 || (!_seekTable.empty() && sample < _seekTable.back().sample + _rate))
+		return;
+
+	SeekPoint point;
+	point.offset = ov_raw_tell(&_ovFile);
+	point.sample = sample;
+	if (point.offset >= 0)
+		_seekTable.push_back(point);
+}
+
+long VorbisStream::decode(char *buffer, int length) {
 #ifdef USE_TREMOR
-		// Tremor ov_read() always returns data as signed 16 bit interleaved PCM
-		// in host byte order. As such, it does not take arguments to request
-		// specific signedness, byte order or bit depth as in Vorbisfile.
-		result = ov_read(&_ovFile, read_pos, len_left,
-						NULL);
+	// Tremor ov_read() always returns data as signed 16 bit interleaved PCM
+	// in host byte order. As such, it does not take arguments to request
+	// specific signedness, byte order or bit depth as in Vorbisfile.
+	return ov_read(&_ovFile, buffer, length,
+					NULL);
 #else
 #ifdef SCUMM_BIG_ENDIAN
-		result = ov_read(&_ovFile, read_pos, len_left,
-						1,
-						2,	// 16 bit
-						1,	// signed
-						NULL);
+	return ov_read(&_ovFile, buffer, length,
+					1,
+					2,	// 16 bit
+					1,	// signed
+					NULL);
 #else
-		result = ov_read(&_ovFile, read_pos, len_left,
-						0,
-						2,	// 16 bit
-						1,	// signed
-						nullptr);
+	return ov_read(&_ovFile, buffer, length,
+					0,
+					2,	// 16 bit
+					1,	// signed
+					nullptr);
 #endif
 #endif
+}
+
+bool VorbisStream::refill() {
+	// Remember where playback has been so far, for later seeks
+	updateSeekTable();
+
+	// Read the samples
+	uint len_left = sizeof(_buffer);
+	char *read_pos = (char *)_buffer;
+
+	while (len_left > 0) {
+		long result = decode(read_pos, len_left);
+
 		if (result == OV_HOLE) {
 			// Possibly recoverable, just warn about it
 			warning("Corrupted data in Vorbis file");
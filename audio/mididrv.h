@@ -258,6 +258,18 @@ public:
 	 */
 	virtual bool isReady(int8 source = -1) { return true; }
 
+	/**
+	 * Set the time at which the following events are due, in microseconds
+	 * after the start of the current timer period. MidiParser calls this
+	 * from its timer callback before it sends each event. A negative value
+	 * means the events are not timed, which is the default.
+	 *
+	 * Drivers generating their output in sync with the timer callbacks
+	 * can use this to play events at their exact sample position, instead
+	 * of at the start of the timer period. Other drivers ignore it.
+	 */
+	virtual void setEventTimeOffset(int32 usecs) { }
+
 protected:
 
 	/**
@@ -515,6 +527,26 @@ public:
 
 	// Does this driver accept soundFont data?
 	virtual bool acceptsSoundFontData() { return false; }
+
+	/**
+	 * Copy the output of an emulated driver to the given stream, or stop
+	 * doing so when passing nullptr. The stream is not owned by the driver.
+	 *
+	 * When recording starts, the sample rate (uint32LE) and the number of
+	 * channels (byte) are written, followed by the generated samples as
+	 * signed 16-bit little endian PCM.
+	 *
+	 * @return false if the driver does not support recording.
+	 */
+	virtual bool setRecordStream(Common::WriteStream *stream) { return false; }
+
+	/**
+	 * Return the number of bytes written to the record stream so far.
+	 *
+	 * Unlike querying the stream itself, this is safe while the driver is
+	 * generating samples in the mixer thread.
+	 */
+	virtual int64 getRecordedSize() { return 0; }
 };
 
 class MidiChannel {
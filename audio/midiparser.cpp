@@ -33,6 +33,7 @@
 MidiParser::MidiParser(int8 source) :
 _source(source),
 _hangingNotesCount(0),
+_dueHangingNotes(0),
 _driver(nullptr),
 _timerRate(0x4A0000),
 _ppqn(96),
@@ -155,7 +156,11 @@ void MidiParser::hangingNote(byte channel, byte note, uint32 timeLeft, bool recy
 
 	for (i = ARRAYSIZE(_hangingNotes); i; --i, ++ptr) {
 		if (ptr->channel == channel && ptr->note == note) {
-			if (ptr->timeLeft && ptr->timeLeft < timeLeft && recycle)
+			// A note that is due in this period has not been counted down
+			// yet, so its time cannot be compared. It ends after the new
+			// note starts, so the new note replaces it.
+			bool due = _dueHangingNotes & (1U << (ptr - _hangingNotes));
+			if (ptr->timeLeft && ptr->timeLeft < timeLeft && recycle && !due)
 				return;
 			best = ptr;
 			if (ptr->timeLeft) {
@@ -180,6 +185,7 @@ void MidiParser::hangingNote(byte channel, byte note, uint32 timeLeft, bool recy
 		best->channel = channel;
 		best->note = note;
 		best->timeLeft = timeLeft;
+		_dueHangingNotes &= ~(1U << (best - _hangingNotes));
 		++_hangingNotesCount;
 	} else {
 		// We checked this up top. We should never get here!
@@ -187,6 +193,31 @@ void MidiParser::hangingNote(byte channel, byte note, uint32 timeLeft, bool recy
 	}
 }
 
+void MidiParser::sendHangingNoteOffs(uint32 until, uint32 minOffset) {
+	while (_dueHangingNotes) {
+		NoteTimer *next = nullptr;
+		for (int i = 0; i < ARRAYSIZE(_hangingNotes); ++i) {
+			if (!(_dueHangingNotes & (1U << i)))
+				continue;
+			NoteTimer *ptr = &_hangingNotes[i];
+			if (!ptr->timeLeft) {
+				// Turned off in the meantime
+				_dueHangingNotes &= ~(1U << i);
+			} else if (ptr->timeLeft <= until && (!next || ptr->timeLeft < next->timeLeft)) {
+				next = ptr;
+			}
+		}
+		if (!next)
+			break;
+
+		_driver->setEventTimeOffset(MAX(next->timeLeft, minOffset));
+		sendToDriver(0x80 | next->channel, next->note, 0);
+		next->timeLeft = 0;
+		--_hangingNotesCount;
+		_dueHangingNotes &= ~(1U << (next - _hangingNotes));
+	}
+}
+
 void MidiParser::onTimer() {
 	uint32 endTime;
 	uint32 eventTime;
@@ -201,17 +232,17 @@ void MidiParser::onTimer() {
 	_abortParse = false;
 	endTime = _position._playTime + _timerRate;
 
-	// Scan our hanging notes for any
-	// that should be turned off.
+	// Scan our hanging notes for any that should be turned off
+	// in this period. Their Note Offs are sent between the parsed
+	// events, so the driver receives all events in time order.
+	_dueHangingNotes = 0;
 	if (_hangingNotesCount) {
 		NoteTimer *ptr = &_hangingNotes[0];
 		int i;
-		for (i = ARRAYSIZE(_hangingNotes); i; --i, ++ptr) {
+		for (i = 0; i < ARRAYSIZE(_hangingNotes); ++i, ++ptr) {
 			if (ptr->timeLeft) {
 				if (ptr->timeLeft <= _timerRate) {
-					sendToDriver(0x80 | ptr->channel, ptr->note, 0);
-					ptr->timeLeft = 0;
-					--_hangingNotesCount;
+					_dueHangingNotes |= 1U << i;
 				} else {
 					ptr->timeLeft -= _timerRate;
 				}
@@ -235,6 +266,18 @@ void MidiParser::onTimer() {
 				return;
 			}
 
+			uint32 offset = eventTime > _position._playTime ? eventTime - _position._playTime : 0;
+			if (info.event == 0xF0 || (info.event == 0xFF && info.ext.type == 0x2F)) {
+				// SysEx and End of Track can stop or delete the parser,
+				// so turn off all notes that are due in this period now.
+				sendHangingNoteOffs(0xFFFFFFFF, offset);
+			} else {
+				sendHangingNoteOffs(offset, offset);
+			}
+
+			// Let the driver play the event at its exact time
+			_driver->setEventTimeOffset(offset);
+
 			if (info.command() == 0x8) {
 				activeNote(info.channel(), info.basic.param1, false);
 			} else if (info.command() == 0x9) {
@@ -260,6 +303,9 @@ void MidiParser::onTimer() {
 		}
 	}
 
+	sendHangingNoteOffs(_timerRate, 0);
+	_driver->setEventTimeOffset(-1);
+
 	if (!_abortParse) {
 		_position._playTime = endTime;
 		_position._playTick = (_position._playTime - _position._lastEventTime) / _psecPerTick + _position._lastEventTick;
@@ -294,6 +294,7 @@ protected:
 	NoteTimer _hangingNotes[32];   ///< Maintains expiration info for up to 32 notes.
 	                                ///< Used for "Smart Jump" and MIDI formats that do not include explicit Note Off events.
 	byte      _hangingNotesCount; ///< Count of hanging notes, used to optimize expiration.
+	uint32    _dueHangingNotes;   ///< Bit mask of the hanging notes that expire during the current onTimer() call.
 
 	MidiDriver_BASE *_driver;    ///< The device to which all events will be transmitted.
 	uint32 _timerRate;     ///< The time in microseconds between onTimer() calls. Obtained from the MidiDriver.
@@ -340,6 +341,18 @@ protected:
 	void hangingNote(byte channel, byte note, uint32 ticksLeft, bool recycle = true);
 	void hangAllActiveNotes();
 
+	/**
+	 * Sends the Note Offs of the hanging notes that are due in the current
+	 * onTimer() call and expire at or before the specified time, earliest
+	 * first, so they are interleaved with the parsed events in time order.
+	 *
+	 * @param until The latest expiration time to send, in microseconds
+	 *              from the start of the current onTimer() period.
+	 * @param minOffset The smallest event time offset to pass to the
+	 *                  driver, so that offsets never go backwards.
+	 */
+	void sendHangingNoteOffs(uint32 until, uint32 minOffset);
+
 	/**
 	 * Called before starting playback of a track.
 	 * Can be implemented by subclasses if they need to
@@ -21,11 +21,22 @@
 
 #include "audio/midiplayer.h"
 #include "audio/midiparser.h"
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
 
 #include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/file.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/system.h"
 
 namespace Audio {
 
+// Size of the rate and channel count written by MidiDriver::setRecordStream()
+static const uint32 kRecordHeaderSize = 5;
+
 MidiPlayer::MidiPlayer() :
 	_driver(nullptr),
 	_parser(nullptr),
@@ -33,7 +44,19 @@ MidiPlayer::MidiPlayer() :
 	_isLooping(false),
 	_isPlaying(false),
 	_masterVolume(0),
-	_nativeMT32(false) {
+	_nativeMT32(false),
+	_renderCache(kMaxRenderCacheTotalSize),
+	_renderBuffer(nullptr),
+	_renderRecording(nullptr),
+	_renderRecordingStarted(false),
+	_renderTailEnd(0),
+	_renderMusicVolume(0),
+	_renderPending(nullptr),
+	_renderPendingSize(0),
+	_renderPendingMusicVolume(0),
+	_renderCachePlaying(false),
+	_renderCacheVolume(0),
+	_inParserTimer(false) {
 
 	memset(_channelsTable, 0, sizeof(_channelsTable));
 	memset(_channelsVolume, 127, sizeof(_channelsVolume));
@@ -47,6 +70,8 @@ MidiPlayer::~MidiPlayer() {
 	// Hopefully, this make no real difference, but we should
 	// watch out for regressions.
 	stop();
+	abortRenderRecording();
+	free(_renderPending);
 
 	// Unhook & unload the driver
 	if (_driver) {
@@ -60,6 +85,7 @@ MidiPlayer::~MidiPlayer() {
 void MidiPlayer::createDriver(int flags) {
 	MidiDriver::DeviceHandle dev = MidiDriver::detectDevice(flags);
 	_nativeMT32 = ((MidiDriver::getMusicType(dev) == MT_MT32) || ConfMan.getBool("native_mt32"));
+	_renderCacheSettings = getRenderCacheSettings(dev);
 
 	_driver = MidiDriver::createMidi(dev);
 	assert(_driver);
@@ -67,6 +93,37 @@ void MidiPlayer::createDriver(int flags) {
 		_driver->property(MidiDriver::PROP_CHANNEL_MASK, 0x03FE);
 }
 
+Common::String MidiPlayer::getRenderCacheSettings(MidiDriver::DeviceHandle dev) const {
+	// The settings which change the output of the emulated drivers
+	static const char *const keys[] = {
+		"opl_driver", "midi_gain", "enable_gs", "soundfont",
+		"fluidsynth_chorus_activate", "fluidsynth_chorus_nr", "fluidsynth_chorus_level",
+		"fluidsynth_chorus_speed", "fluidsynth_chorus_depth", "fluidsynth_chorus_waveform",
+		"fluidsynth_reverb_activate", "fluidsynth_reverb_roomsize", "fluidsynth_reverb_damping",
+		"fluidsynth_reverb_width", "fluidsynth_reverb_level", "fluidsynth_misc_interpolation"
+	};
+
+	Common::String driverId = MidiDriver::getDeviceString(dev, MidiDriver::kDriverId);
+	Common::String settings = Common::String::format("%s-%s-%d-%d", driverId.c_str(),
+		MidiDriver::getDeviceString(dev, MidiDriver::kDeviceName).c_str(), _nativeMT32,
+		g_system->getMixer()->getOutputRate());
+
+	for (int i = 0; i < ARRAYSIZE(keys); i++) {
+		if (ConfMan.hasKey(keys[i]))
+			settings += Common::String::format("-%s=%s", keys[i], ConfMan.get(keys[i]).c_str());
+	}
+
+	// Different ROM versions sound differently. The emulator prefers the
+	// CM-32L ROMs if they are present.
+	if (driverId == "mt32") {
+		Common::File controlRom;
+		if (controlRom.open("CM32L_CONTROL.ROM") || controlRom.open("MT32_CONTROL.ROM"))
+			settings += "-" + Common::computeStreamMD5AsString(controlRom);
+	}
+
+	return settings;
+}
+
 
 void MidiPlayer::setVolume(int volume) {
 	volume = CLIP(volume, 0, 255);
@@ -76,6 +133,14 @@ void MidiPlayer::setVolume(int volume) {
 	Common::StackLock lock(_mutex);
 
 	_masterVolume = volume;
+
+	// The recorded output would not match the MIDI data anymore
+	endRenderRecording();
+	if (_renderCachePlaying) {
+		int channelVolume = _renderCacheVolume ? _masterVolume * Audio::Mixer::kMaxChannelVolume / _renderCacheVolume : 0;
+		g_system->getMixer()->setChannelVolume(_renderCacheHandle, MIN<int>(channelVolume, Audio::Mixer::kMaxChannelVolume));
+	}
+
 	for (int i = 0; i < kNumChannels; ++i) {
 		if (_channelsTable[i]) {
 			_channelsTable[i]->volume(_channelsVolume[i] * _masterVolume / 255);
@@ -93,6 +158,10 @@ void MidiPlayer::syncVolume() {
 
 
 void MidiPlayer::send(uint32 b) {
+	// Anything not coming from the parser would end up in the recording
+	if (_renderRecording && !_inParserTimer)
+		endRenderRecording();
+
 	byte ch = (byte)(b & 0x0F);
 	if ((b & 0xFFF0) == 0x07B0) {
 		// Adjust volume changes by master volume
@@ -125,6 +194,14 @@ void MidiPlayer::sendToChannel(byte ch, uint32 b) {
 void MidiPlayer::metaEvent(byte type, byte *data, uint16 length) {
 	switch (type) {
 	case 0x2F:	// End of Track
+		if (_renderRecording) {
+			// A looping track starts over right away, so its recording
+			// ends at the loop point
+			if (_isLooping)
+				finishRenderRecording();
+			else
+				startRenderTail();
+		}
 		endOfTrack();
 		break;
 	default:
@@ -133,6 +210,11 @@ void MidiPlayer::metaEvent(byte type, byte *data, uint16 length) {
 	}
 }
 
+void MidiPlayer::setEventTimeOffset(int32 usecs) {
+	if (_driver)
+		_driver->setEventTimeOffset(usecs);
+}
+
 void MidiPlayer::endOfTrack() {
 	if (_isLooping) {
 		assert(_parser);
@@ -152,16 +234,210 @@ void MidiPlayer::onTimer() {
 	// TODO: Maybe we can replace _isPlaying
 	// by a simple check for "_parser != 0" ?
 
+	if (_isPlaying && _renderCachePlaying) {
+		// The track is played from the render cache, so only watch for its end
+		if (!g_system->getMixer()->isSoundHandleActive(_renderCacheHandle))
+			endOfTrack();
+		return;
+	}
+
+	// The mixer thread may be writing to the recording, so the driver has
+	// to be asked for its size
+	if (_renderRecording) {
+		int64 recorded = _driver->getRecordedSize();
+		if (_renderTailEnd && recorded >= _renderTailEnd)
+			finishRenderRecording();
+		else if (recorded >= kMaxRenderCacheSize)
+			abortRenderRecording();
+	}
+
 	if (_isPlaying && _parser) {
+		// Start the recording with the first tick of the track, so that it
+		// doesn't depend on how long it took the track to start
+		if (_renderRecording && !_renderRecordingStarted) {
+			_renderRecordingStarted = true;
+			_driver->setRecordStream(_renderRecording);
+		}
+
+		_inParserTimer = true;
 		_parser->onTimer();
+		_inParserTimer = false;
 	}
 }
 
+void MidiPlayer::startRenderCache(const byte *data, uint32 size) {
+	// Store the last complete recording, now that we are not called from
+	// the mixer thread anymore
+	endRenderRecording();
+	flushRenderCache();
+	stopRenderCache();
+
+	if (!_driver || !ConfMan.hasKey("music_render_cache") || !ConfMan.getBool("music_render_cache"))
+		return;
+
+	// The output depends on the MIDI data, the driver and the master volume.
+	// Looping tracks are recorded without the tail.
+	Common::MemoryReadStream dataStream(data, size);
+	Common::String key = Common::computeStreamMD5AsString(dataStream);
+	key += Common::String::format("-%s-%d-%d", _renderCacheSettings.c_str(), _masterVolume, _isLooping);
+
+	Audio::Mixer *mixer = g_system->getMixer();
+
+	Audio::SeekableAudioStream *stream = _renderCache.makeStream(key);
+	if (stream) {
+		Audio::AudioStream *output = _isLooping ? Audio::makeLoopingAudioStream(stream, 0) : stream;
+
+		// The music volume of the mixer was divided out of the recording,
+		// so that the music volume and mute settings apply to it like to
+		// any other music
+		mixer->playStream(Audio::Mixer::kMusicSoundType, &_renderCacheHandle, output);
+		_renderCachePlaying = true;
+		_renderCacheVolume = _masterVolume;
+		debug(3, "MidiPlayer: Playing track from the render cache");
+		return;
+	}
+
+	// Only emulated drivers can record their output
+	int musicVolume = mixer->getVolumeForSoundType(Audio::Mixer::kMusicSoundType);
+	if (musicVolume <= 0 || !_driver->setRecordStream(nullptr))
+		return;
+
+	// The recording is written by the mixer thread, so it must not have to
+	// grow its buffer
+	_renderBuffer = (byte *)malloc(kMaxRenderCacheSize);
+	if (!_renderBuffer) {
+		warning("MidiPlayer: Not enough memory to record the track");
+		return;
+	}
+
+	// Cut off notes still sounding from earlier tracks, so that they don't
+	// end up in the recording
+	for (int ch = 0; ch < kNumChannels; ch++) {
+		_driver->send(0x78B0 | ch); // All Sound Off
+		_driver->send(0x7BB0 | ch); // All Notes Off
+	}
+
+	_renderRecording = new Common::MemoryWriteStream(_renderBuffer, kMaxRenderCacheSize);
+	_renderRecordingStarted = false;
+	_renderCacheKey = key;
+	_renderMusicVolume = musicVolume;
+}
+
+void MidiPlayer::stopRenderCache() {
+	// The tail of a recording continues after the track has been stopped
+	if (!_renderTailEnd)
+		abortRenderRecording();
+
+	if (_renderCachePlaying) {
+		g_system->getMixer()->stopHandle(_renderCacheHandle);
+		_renderCachePlaying = false;
+	}
+}
+
+void MidiPlayer::startRenderTail() {
+	uint32 rate = READ_LE_UINT32(_renderBuffer);
+	uint32 frameSize = _renderBuffer[4] * 2;
+
+	// Keep recording until the voices have decayed
+	int64 tailEnd = _driver->getRecordedSize() + (int64)rate * kRenderCacheTail / 1000 * frameSize;
+	_renderTailEnd = (uint32)MIN<int64>(tailEnd, kMaxRenderCacheSize);
+}
+
+void MidiPlayer::endRenderRecording() {
+	// During the tail, the track itself is complete already
+	if (_renderTailEnd)
+		finishRenderRecording();
+	else
+		abortRenderRecording();
+}
+
+void MidiPlayer::finishRenderRecording() {
+	if (!_renderRecording)
+		return;
+
+	_driver->setRecordStream(nullptr);
+	uint32 size = _renderRecording->pos();
+
+	// Drop the silence at the end of the tail
+	if (_renderTailEnd && size >= kRecordHeaderSize) {
+		const uint32 frameSize = _renderBuffer[4] * 2;
+		while (size >= kRecordHeaderSize + frameSize) {
+			const byte *frame = _renderBuffer + size - frameSize;
+			uint32 i = 0;
+			while (i < frameSize && frame[i] == 0)
+				i++;
+			if (i < frameSize)
+				break;
+			size -= frameSize;
+		}
+	}
+
+	// The recording is stored once the player is used again, since this
+	// may run in the mixer thread
+	free(_renderPending);
+	_renderPending = _renderBuffer;
+	_renderPendingSize = size;
+	_renderPendingKey = _renderCacheKey;
+	_renderPendingMusicVolume = _renderMusicVolume;
+
+	delete _renderRecording;
+	_renderRecording = nullptr;
+	_renderBuffer = nullptr;
+	_renderTailEnd = 0;
+}
+
+void MidiPlayer::abortRenderRecording() {
+	if (!_renderRecording)
+		return;
+
+	_driver->setRecordStream(nullptr);
+	delete _renderRecording;
+	_renderRecording = nullptr;
+	free(_renderBuffer);
+	_renderBuffer = nullptr;
+	_renderTailEnd = 0;
+}
+
+void MidiPlayer::flushRenderCache() {
+	if (!_renderPending)
+		return;
+
+	byte *data = _renderPending;
+	_renderPending = nullptr;
+
+	if (_renderPendingSize <= kRecordHeaderSize) {
+		free(data);
+		return;
+	}
+
+	const uint32 rate = READ_LE_UINT32(data);
+	const bool stereo = (data[4] == 2);
+	const uint32 samples = (_renderPendingSize - kRecordHeaderSize) / 2;
+
+	// Move the samples over the header, and divide out the music volume
+	// of the mixer, which is applied again when the recording is played.
+	// Each sample is written before the one it is read from.
+	int16 *pcm = (int16 *)data;
+	for (uint32 i = 0; i < samples; i++) {
+		int sample = (int16)READ_LE_UINT16(data + kRecordHeaderSize + i * 2);
+		sample = sample * Audio::Mixer::kMaxMixerVolume / _renderPendingMusicVolume;
+		pcm[i] = CLIP<int>(sample, -32768, 32767);
+	}
+
+	// Give back the rest of the preallocated buffer
+	int16 *shrunk = (int16 *)realloc(pcm, samples * sizeof(int16));
+	if (shrunk)
+		pcm = shrunk;
+
+	delete _renderCache.insert(_renderPendingKey, pcm, samples * sizeof(int16), rate, stereo);
+}
+
 
 void MidiPlayer::stop() {
 	Common::StackLock lock(_mutex);
 
 	_isPlaying = false;
+	stopRenderCache();
 	if (_parser) {
 		_parser->unloadMusic();
 
@@ -183,11 +459,15 @@ void MidiPlayer::pause() {
 //	debugC(2, kDraciSoundDebugLevel, "Pausing track %d", _track);
 	_isPlaying = false;
 	setVolume(-1);	// FIXME: This should be 0, shouldn't it?
+	if (_renderCachePlaying)
+		g_system->getMixer()->pauseHandle(_renderCacheHandle, true);
 }
 
 void MidiPlayer::resume() {
 //	debugC(2, kDraciSoundDebugLevel, "Resuming track %d", _track);
 	syncVolume();
+	if (_renderCachePlaying)
+		g_system->getMixer()->pauseHandle(_renderCacheHandle, false);
 	_isPlaying = true;
 }
 
@@ -24,10 +24,17 @@
 
 #include "common/scummsys.h"
 #include "common/mutex.h"
+#include "common/str.h"
 #include "audio/mididrv.h"
+#include "audio/mixer.h"
+#include "audio/soundcache.h"
 
 class MidiParser;
 
+namespace Common {
+class MemoryWriteStream;
+}
+
 namespace Audio {
 
 /**
@@ -124,6 +131,7 @@ public:
 	// MidiDriver_BASE implementation
 	void send(uint32 b) override;
 	void metaEvent(byte type, byte *data, uint16 length) override;
+	void setEventTimeOffset(int32 usecs) override;
 
 protected:
 	/**
@@ -148,6 +156,73 @@ protected:
 
 	void createDriver(int flags = MDT_MIDI | MDT_ADLIB | MDT_PREFER_GM);
 
+	/**
+	 * Look up the given MIDI data in the render cache. This should be
+	 * called by subclasses once the data has been loaded into _parser,
+	 * and after _isLooping has been set.
+	 *
+	 * The render cache is only used when the 'music_render_cache' setting
+	 * is enabled and the driver is an emulated one. If the rendered output
+	 * of the track is found, it is played through the mixer as music, and
+	 * _parser is not driven anymore. Otherwise, the output of the driver is
+	 * recorded from the first tick of the track until its voices have
+	 * decayed after the end, and kept in memory for later plays. Looping
+	 * tracks are recorded up to the loop point instead.
+	 *
+	 * Changes of the master volume while recording abort the recording,
+	 * since the output would not match the MIDI data anymore. The same
+	 * happens when MIDI data which doesn't come from _parser is sent
+	 * through the player. Subclasses must not use the render cache if they
+	 * send other data to _driver directly, e.g. sound effects.
+	 */
+	void startRenderCache(const byte *data, uint32 size);
+
+private:
+	enum {
+		/**
+		 * The maximum size of a recording, in bytes. Longer tracks are
+		 * not cached. This much memory is allocated for each recording.
+		 */
+		kMaxRenderCacheSize = 32 * 1024 * 1024,
+
+		/**
+		 * The maximum size of all recordings. The least recently played
+		 * ones are dropped when it is exceeded.
+		 */
+		kMaxRenderCacheTotalSize = 64 * 1024 * 1024,
+
+		/**
+		 * How long the recording goes on after the end of a track, in
+		 * milliseconds, for the voices to decay.
+		 */
+		kRenderCacheTail = 3000
+	};
+
+	Common::String getRenderCacheSettings(MidiDriver::DeviceHandle dev) const;
+	void stopRenderCache();
+	void startRenderTail();
+	void endRenderRecording();
+	void finishRenderRecording();
+	void abortRenderRecording();
+	void flushRenderCache();
+
+	Audio::SoundCache _renderCache;
+	Common::String _renderCacheSettings;
+	Common::String _renderCacheKey;
+	byte *_renderBuffer;
+	Common::MemoryWriteStream *_renderRecording;
+	bool _renderRecordingStarted;
+	uint32 _renderTailEnd;
+	int _renderMusicVolume;
+	byte *_renderPending;
+	uint32 _renderPendingSize;
+	Common::String _renderPendingKey;
+	int _renderPendingMusicVolume;
+	Audio::SoundHandle _renderCacheHandle;
+	bool _renderCachePlaying;
+	int _renderCacheVolume;
+	bool _inParserTimer;
+
 protected:
 	enum {
 		/**
@@ -46,7 +46,8 @@ public:
 	~Channel();
 
 	/**
-	 * Mixes the channel's samples into the given buffer.
+	 * Mixes the channel's samples into the given buffer. 16-bit samples
+	 * are clamped, float samples are not.
 	 *
 	 * @param data buffer where to mix the data
 	 * @param len  number of sample *pairs*. So a value of
@@ -54,7 +55,8 @@ public:
 	 *             16 bits, for a total of 40 bytes.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	template<typename T>
+	int mix(T *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -301,22 +303,30 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
+	// we store 16-bit samples
+	assert(len % 2 == 0);
+	return mixChannels((int16 *)samples, len >> 1);
+}
+
+int MixerImpl::mixCallback(float *samples, uint numSamples) {
+	assert(samples);
 
-	int16 *buf = (int16 *)samples;
+	return mixChannels(samples, numSamples);
+}
+
+template<typename T>
+int MixerImpl::mixChannels(T *buf, uint numSamples) {
+	Common::StackLock lock(_mutex);
 
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
 	//  zero the buf
-	memset(buf, 0, len);
+	memset(buf, 0, numSamples * sizeof(T));
 
-	// we store 16-bit samples
+	uint len = numSamples;
 	if (_stereo) {
-		assert(len % 4 == 0);
-		len >>= 2;
-	} else {
-		assert(len % 2 == 0);
+		assert(numSamples % 2 == 0);
 		len >>= 1;
 	}
 
@@ -707,7 +717,8 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+template<typename T>
+int Channel::mix(T *data, uint len) {
 	assert(_stream);
 	assert(_converter);
 
@@ -139,6 +139,16 @@ public:
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+	/**
+	 * Clears the buffer and mixes all playing channels into it.
+	 *
+	 * @param buf Sample buffer, 16-bit or float.
+	 * @param numSamples Number of samples in the buffer (should be even for stereo).
+	 * @return number of sample pairs processed (which can still be silence!)
+	 */
+	template<typename T>
+	int mixChannels(T *buf, uint numSamples);
+
 public:
 	/**
 	 * The mixer callback function, to be called at regular intervals by
@@ -151,6 +161,17 @@ public:
 	 */
 	int mixCallback(byte *samples, uint len);
 
+	/**
+	 * The float variant of the mixer callback, for backends which can output
+	 * float samples directly. The channels are mixed with full precision and
+	 * without clamping, leaving clipping to the backend or the audio device.
+	 *
+	 * @param samples Sample buffer, in which (interleaved stereo) float samples in the range [-1, 1] will be stored.
+	 * @param numSamples Number of float samples in the buffer (should be even for stereo).
+	 * @return number of sample pairs processed (which can still be silence!)
+	 */
+	int mixCallback(float *samples, uint numSamples);
+
 	/**
 	 * Set the internal 'is ready' flag of the mixer.
 	 * Backends should invoke Mixer::setReady(true) once initialisation of
@@ -10,6 +10,7 @@ MODULE_OBJS := \
 	fmopl.o \
 	mac_plugin.o \
 	mididrv.o \
+	mididrv_base.o \
 	mididrv_ms.o \
 	midiparser_qt.o \
 	midiparser_smf.o \
@@ -24,6 +25,7 @@ MODULE_OBJS := \
 	musicplugin.o \
 	null.o \
 	rate.o \
+	soundcache.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -45,24 +45,101 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Sample type specific operations of the rate converters.
+ *
+ * The 16-bit path quantizes after applying the volume and clamps while
+ * mixing into the output, as the mixer always has. The float path keeps
+ * the full precision of the input and leaves clipping to the backend.
+ */
+template<typename T>
+struct RateSample;
+
+template<>
+struct RateSample<st_sample_t> {
+	typedef st_sample_t Scaled;
+
+	static int read(AudioStream &input, st_sample_t *buffer, int numSamples) {
+		return input.readBuffer(buffer, numSamples);
+	}
+
+	static st_sample_t interpolate(st_sample_t last, st_sample_t cur, frac_t frac) {
+		return (st_sample_t)(last + (((cur - last) * frac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+	}
+
+	static Scaled scale(st_sample_t sample, st_volume_t vol) {
+		return (sample * (int)vol) / Audio::Mixer::kMaxMixerVolume;
+	}
+
+	static void mix(st_sample_t &out, Scaled sample) {
+		clampedAdd(out, sample);
+	}
+
+	static void mixMono(st_sample_t &out, Scaled left, Scaled right) {
+		clampedAdd(out, (left + right) / 2);
+	}
+};
+
+template<>
+struct RateSample<float> {
+	typedef float Scaled;
+
+	static int read(AudioStream &input, float *buffer, int numSamples) {
+		return input.readBufferFloat(buffer, numSamples);
+	}
+
+	static float interpolate(float last, float cur, frac_t frac) {
+		return last + (cur - last) * (frac * (1.0f / FRAC_ONE_LOW));
+	}
+
+	static Scaled scale(float sample, st_volume_t vol) {
+		return sample * (vol * (1.0f / Audio::Mixer::kMaxMixerVolume));
+	}
+
+	static void mix(float &out, Scaled sample) {
+		out += sample;
+	}
+
+	static void mixMono(float &out, Scaled left, Scaled right) {
+		out += (left + right) * 0.5f;
+	}
+};
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
 	/** Input and output rates */
 	st_rate_t _inRate, _outRate;
 
-	/**
-	 * The intermediate input cache. Bigger values may increase performance,
-	 * but only until some point (depends largely on cache size, target
-	 * processor and various other factors), at which it will decrease again.
-	 */
-	st_sample_t _buffer[512];
+	/** Input buffering and interpolation state for one sample type */
+	template<typename T>
+	struct State {
+		State() : bufferPos(nullptr), bufferSize(0), inLastL(0), inLastR(0), inCurL(0), inCurR(0) {}
+
+		/**
+		 * The intermediate input cache. Bigger values may increase performance,
+		 * but only until some point (depends largely on cache size, target
+		 * processor and various other factors), at which it will decrease again.
+		 */
+		T buffer[512];
+
+		/** Current position inside the buffer */
+		const T *bufferPos;
+
+		/** Size of data currently loaded into the buffer */
+		int bufferSize;
+
+		/** Last sample(s) in the input stream (left/right channel) */
+		T inLastL, inLastR;
 
-	/** Current position inside the buffer */
-	const st_sample_t *_bufferPos;
+		/** Current sample(s) in the input stream (left/right channel) */
+		T inCurL, inCurR;
+	};
 
-	/** Size of data currently loaded into the buffer */
-	int _bufferSize;
+	State<st_sample_t> _state;
+
+	/** State of the float path, only allocated once it is used */
+	State<float> *_floatState;
 
 	/** How far output is ahead of input when doing simple conversion */
 	frac_t _outPos;
@@ -70,21 +147,39 @@ private:
 	/** Fractional position of the output stream in input stream unit */
 	frac_t _outPosFrac;
 
-	/** Last sample(s) in the input stream (left/right channel) */
-	st_sample_t _inLastL, _inLastR;
-	
-	/** Current sample(s) in the input stream (left/right channel) */
-	st_sample_t _inCurL, _inCurR;
+	template<typename T>
+	int doConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int copyConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int simpleConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int interpolateConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+
+	template<typename T>
+	static void output(T *outBuffer, T inL, T inR, st_volume_t volL, st_volume_t volR) {
+		typename RateSample<T>::Scaled outL, outR;
+		outL = RateSample<T>::scale(inL, volL);
+		outR = RateSample<T>::scale(inR, volR);
+
+		if (outStereo) {
+			// Output left channel
+			RateSample<T>::mix(outBuffer[reverseStereo    ], outL);
 
-	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+			// Output right channel
+			RateSample<T>::mix(outBuffer[reverseStereo ^ 1], outR);
+		} else {
+			// Output mono channel
+			RateSample<T>::mixMono(outBuffer[0], outL, outR);
+		}
+	}
 
 public:
 	RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
-	virtual ~RateConverter_Impl() {}
+	virtual ~RateConverter_Impl() { delete _floatState; }
 
 	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+	int convert(AudioStream &input, float *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
 
 	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
 	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
@@ -92,61 +187,47 @@ public:
 	st_rate_t getInputRate() const override { return _inRate; }
 	st_rate_t getOutputRate() const override { return _outRate; }
 
-	bool needsDraining() const override { return _bufferSize != 0; }
+	bool needsDraining() const override { return _state.bufferSize != 0 || (_floatState && _floatState->bufferSize != 0); }
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
-	st_sample_t *outStart, *outEnd;
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	T *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
 	while (outBuffer < outEnd) {
 		// Check if we have to refill the buffer
-		if (_bufferSize == 0) {
-			_bufferPos = _buffer;
-			_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+		if (state.bufferSize == 0) {
+			state.bufferPos = state.buffer;
+			state.bufferSize = RateSample<T>::read(input, state.buffer, ARRAYSIZE(state.buffer));
 
-			if (_bufferSize <= 0)
+			if (state.bufferSize <= 0)
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
 		// Mix the data into the output buffer
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-		_bufferSize -= (inStereo ? 2 : 1);
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+		T inL, inR;
+		inL = *state.bufferPos++;
+		inR = (inStereo ? *state.bufferPos++ : inL);
+		state.bufferSize -= (inStereo ? 2 : 1);
 
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		output(outBuffer, inL, inR, volL, volR);
+		outBuffer += (outStereo ? 2 : 1);
 	}
 
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPos by
 	frac_t outPos_inc = _inRate / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	T *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -155,57 +236,42 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 		// Read enough input samples so that _outPos >= 0
 		do {
 			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+			if (state.bufferSize == 0) {
+				state.bufferPos = state.buffer;
+				state.bufferSize = RateSample<T>::read(input, state.buffer, ARRAYSIZE(state.buffer));
 
-				if (_bufferSize <= 0)
+				if (state.bufferSize <= 0)
 					return (outBuffer - outStart) / (outStereo ? 2 : 1);
 			}
 
-			_bufferSize -= (inStereo ? 2 : 1);
+			state.bufferSize -= (inStereo ? 2 : 1);
 			_outPos--;
 
 			if (_outPos >= 0) {
-				_bufferPos += (inStereo ? 2 : 1);
+				state.bufferPos += (inStereo ? 2 : 1);
 			}
 		} while (_outPos >= 0);
 
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
+		T inL, inR;
+		inL = *state.bufferPos++;
+		inR = (inStereo ? *state.bufferPos++ : inL);
 
 		// Increment output position
 		_outPos += outPos_inc;
 
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		output(outBuffer, inL, inR, volL, volR);
+		outBuffer += (outStereo ? 2 : 1);
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPosFrac by
 	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	T *outStart, *outEnd;
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
@@ -213,21 +279,21 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 		// Read enough input samples so that _outPosFrac < 0
 		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
 			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+			if (state.bufferSize == 0) {
+				state.bufferPos = state.buffer;
+				state.bufferSize = RateSample<T>::read(input, state.buffer, ARRAYSIZE(state.buffer));
 
-				if (_bufferSize <= 0)
+				if (state.bufferSize <= 0)
 					return (outBuffer - outStart) / (outStereo ? 2 : 1);
 			}
 
-			_bufferSize -= (inStereo ? 2 : 1);
-			_inLastL = _inCurL;
-			_inCurL = *_bufferPos++;
+			state.bufferSize -= (inStereo ? 2 : 1);
+			state.inLastL = state.inCurL;
+			state.inCurL = *state.bufferPos++;
 
 			if (inStereo) {
-				_inLastR = _inCurR;
-				_inCurR = *_bufferPos++;
+				state.inLastR = state.inCurR;
+				state.inCurR = *state.bufferPos++;
 			}
 
 			_outPosFrac -= FRAC_ONE_LOW;
@@ -237,30 +303,14 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 		// still space in the output buffer.
 		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
 			// Interpolate
-			st_sample_t inL, inR;
-			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+			T inL, inR;
+			inL = RateSample<T>::interpolate(state.inLastL, state.inCurL, _outPosFrac);
 			inR = (inStereo ?
-						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
+						RateSample<T>::interpolate(state.inLastR, state.inCurR, _outPosFrac) :
 						inL);
 
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
-			}
+			output(outBuffer, inL, inR, volL, volR);
+			outBuffer += (outStereo ? 2 : 1);
 
 			// Increment output position
 			_outPosFrac += outPos_inc;
@@ -273,30 +323,39 @@ template<bool inStereo, bool outStereo, bool reverseStereo>
 RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate) :
 	_inRate(inputRate),
 	_outRate(outputRate),
+	_floatState(nullptr),
 	_outPos(1),
-	_outPosFrac(FRAC_ONE_LOW),
-	_inLastL(0),
-	_inLastR(0),
-	_inCurL(0),
-	_inCurR(0),
-	_bufferSize(0),
-	_bufferPos(nullptr) {}
+	_outPosFrac(FRAC_ONE_LOW) {}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::doConvert(State<T> &state, AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	assert(input.isStereo() == inStereo);
 
 	if (_inRate == _outRate) {
-		return copyConvert(input, outBuffer, numSamples, volL, volR);
+		return copyConvert(state, input, outBuffer, numSamples, volL, volR);
 	} else {
 		if ((_inRate % _outRate) == 0 && (_inRate < 65536)) {
-			return simpleConvert(input, outBuffer, numSamples, volL, volR);
+			return simpleConvert(state, input, outBuffer, numSamples, volL, volR);
 		} else {
-			return interpolateConvert(input, outBuffer, numSamples, volL, volR);
+			return interpolateConvert(state, input, outBuffer, numSamples, volL, volR);
 		}
 	}
 }
 
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	return doConvert(_state, input, outBuffer, numSamples, volL, volR);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, float *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	if (!_floatState)
+		_floatState = new State<float>();
+
+	return doConvert(*_floatState, input, outBuffer, numSamples, volL, volR);
+}
+
 RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
 	if (inStereo) {
 		if (outStereo) {
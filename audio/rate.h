@@ -90,6 +90,18 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream to the target sample rate, reading and
+	 * mixing float samples in the range [-1, 1].
+	 *
+	 * Unlike the 16-bit variant, this neither quantizes the input nor clamps
+	 * the output, so that can be left to the final output stage. A converter
+	 * is meant to be used with only one of the two variants.
+	 *
+	 * @see convert(AudioStream &, st_sample_t *, st_size_t, st_volume_t, st_volume_t)
+	 */
+	virtual int convert(AudioStream &input, float *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
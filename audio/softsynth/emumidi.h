@@ -26,6 +26,8 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+#include "common/mutex.h"
+
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -43,9 +45,19 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	Common::WriteStream *_recordStream;
+	Common::Mutex _recordMutex;
+
 protected:
 	int _baseFreq;
 
+	/**
+	 * The time of the events currently being sent, in microseconds after
+	 * the start of the timer period that is about to be generated, or -1
+	 * when the events are to be played immediately.
+	 */
+	int32 _eventTimeOffset;
+
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
@@ -57,7 +69,9 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
-		_baseFreq(250) {
+		_recordStream(nullptr),
+		_baseFreq(250),
+		_eventTimeOffset(-1) {
 	}
 
 	// MidiDriver API
@@ -86,6 +100,27 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
+	virtual void setEventTimeOffset(int32 usecs) {
+		_eventTimeOffset = usecs;
+	}
+
+	virtual bool setRecordStream(Common::WriteStream *stream) {
+		Common::StackLock lock(_recordMutex);
+
+		_recordStream = stream;
+		if (_recordStream) {
+			_recordStream->writeUint32LE(getRate());
+			_recordStream->writeByte(isStereo() ? 2 : 1);
+		}
+
+		return true;
+	}
+
+	virtual int64 getRecordedSize() {
+		Common::StackLock lock(_recordMutex);
+		return _recordStream ? _recordStream->pos() : 0;
+	}
+
 	// AudioStream API
 	virtual int readBuffer(int16 *data, const int numSamples) {
 		const int stereoFactor = isStereo() ? 2 : 1;
@@ -99,10 +134,19 @@ public:
 
 			generateSamples(data, step);
 
+			if (_recordStream) {
+				Common::StackLock lock(_recordMutex);
+				if (_recordStream) {
+					for (int i = 0; i < step * stereoFactor; i++)
+						_recordStream->writeSint16LE(data[i]);
+				}
+			}
+
 			_nextTick -= step << FIXP_SHIFT;
 			if (!(_nextTick >> FIXP_SHIFT)) {
 				if (_timerProc)
 					(*_timerProc)(_timerParam);
+				_eventTimeOffset = -1;
 
 				onTimer();
 
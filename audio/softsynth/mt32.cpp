@@ -39,6 +39,7 @@
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/osd_message_queue.h"
+#include "common/timer.h"
 
 #include "graphics/fontman.h"
 #include "graphics/surface.h"
@@ -109,6 +110,13 @@ class MidiChannel_MT32 : public MidiChannel_MPU401 {
 
 class MidiDriver_MT32 : public MidiDriver_Emulated {
 private:
+	enum {
+		kRenderAheadChunk = 256,      ///< Number of sample frames rendered ahead at once
+		kMaxRenderAhead = 1000,       ///< Largest accepted render-ahead latency, in milliseconds
+		kMinRenderAheadInterval = 10, ///< Shortest render-ahead timer interval, in milliseconds
+		kMaxRenderAheadInterval = 50  ///< Longest render-ahead timer interval, in milliseconds
+	};
+
 	MidiChannel_MT32 _midiChannels[16];
 	uint16 _channelMask;
 	MT32Emu::Service _service;
@@ -118,6 +126,22 @@ private:
 
 	int _outputRate;
 
+	// Render-ahead support. When enabled, the synth is rendered from a timer
+	// callback into a ring buffer, and the mixer only copies samples out.
+	int16 *_ringBuffer;
+	uint32 _ringSize;    ///< Size of the ring buffer, in sample frames
+	uint32 _ringTarget;  ///< Number of sample frames to keep rendered ahead
+	uint32 _renderAheadStep; ///< Largest number of sample frames rendered by one timer callback
+	uint32 _ringRead;
+	uint32 _ringFill;
+	uint32 _underruns;
+	Common::Mutex _ringMutex;
+
+	static void renderAheadTimerProc(void *refCon);
+	void renderAhead(uint32 maxFrames);
+
+	uint32 getEventTimestamp();
+
 protected:
 	void generateSamples(int16 *buf, int len) override;
 
@@ -136,6 +160,7 @@ public:
 	MidiChannel *getPercussionChannel() override;
 
 	// AudioStream API
+	int readBuffer(int16 *data, const int numSamples) override;
 	bool isStereo() const override { return true; }
 	int getRate() const override { return _outputRate; }
 };
@@ -155,6 +180,14 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+
+	_ringBuffer = nullptr;
+	_ringSize = 0;
+	_ringTarget = 0;
+	_renderAheadStep = 0;
+	_ringRead = 0;
+	_ringFill = 0;
+	_underruns = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -220,6 +253,40 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
+	// The optional render-ahead latency is specified in milliseconds. Music
+	// timer callbacks keep running from within the rendering, so events
+	// coming from the music player stay in sync with the samples.
+	int latency = ConfMan.hasKey("mt32_render_ahead") ? ConfMan.getInt("mt32_render_ahead") : 0;
+	if (latency > kMaxRenderAhead) {
+		warning("MT-32 render-ahead of %d ms is too large, using %d ms", latency, kMaxRenderAhead);
+		latency = kMaxRenderAhead;
+	}
+	if (latency > 0) {
+		// Keep at least two mixer buffers rendered, or the mixer would run
+		// dry on every callback
+		const uint32 mixerFrames = (uint32)((uint64)_mixer->getOutputBufSize() * _outputRate / MAX<uint>(_mixer->getOutputRate(), 1));
+		_ringTarget = MAX<uint32>((uint32)((uint64)_outputRate * latency / 1000), 2 * mixerFrames);
+		_ringTarget = MAX<uint32>(_ringTarget, kRenderAheadChunk);
+		_ringSize = _ringTarget + kRenderAheadChunk;
+		_ringBuffer = new int16[_ringSize * 2]();
+		_ringRead = 0;
+		_ringFill = 0;
+		_underruns = 0;
+
+		// Prime the buffer before the mixer starts pulling samples
+		renderAhead(_ringTarget);
+
+		// Refill four times per latency period. The timer thread is shared
+		// with all other timer callbacks, so each refill renders at most
+		// twice the samples played in one interval, which bounds the time
+		// it takes while still letting it catch up.
+		const uint32 targetMillis = (uint32)((uint64)_ringTarget * 1000 / _outputRate);
+		const uint32 interval = CLIP<uint32>(targetMillis / 4, kMinRenderAheadInterval, kMaxRenderAheadInterval);
+		_renderAheadStep = MAX<uint32>(2 * _outputRate * interval / 1000, kRenderAheadChunk);
+		g_system->getTimerManager()->installTimerProc(&renderAheadTimerProc, interval * 1000, this, "MT32RenderAhead");
+		debug(1, "MT-32 emulator renders %d ms ahead", targetMillis);
+	}
+
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
@@ -229,7 +296,17 @@ void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
 
 	Common::StackLock lock(_mutex);
-	_service.playMsg(b);
+	if (_eventTimeOffset >= 0)
+		_service.playMsgAt(b, getEventTimestamp());
+	else
+		_service.playMsg(b);
+}
+
+uint32 MidiDriver_MT32::getEventTimestamp() {
+	// The synth has rendered up to the start of the timer period the
+	// event belongs to, so only add the offset into that period.
+	uint32 outputOffset = (uint32)((uint64)_eventTimeOffset * _outputRate / 1000000);
+	return _service.getInternalRenderedSampleCount() + _service.convertOutputToSynthTimestamp(outputOffset);
 }
 
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
@@ -247,14 +324,33 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	midiDriverCommonSysEx(msg, length);
 	if (msg[0] == 0xf0) {
 		Common::StackLock lock(_mutex);
-		_service.playSysex(msg, length);
+		if (_eventTimeOffset >= 0)
+			_service.playSysexAt(msg, length, getEventTimestamp());
+		else
+			_service.playSysex(msg, length);
 	} else {
 		enum {
 			SYSEX_CMD_DT1 = 0x12,
 			SYSEX_CMD_DAT = 0x42
 		};
 
-		if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
+		if ((msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) && _eventTimeOffset >= 0) {
+			// Queue the message with the timed events around it, so they
+			// stay in order. The checksum is recalculated, since it's
+			// ignored for messages written directly below.
+			byte *sysex = new byte[length + 2];
+			sysex[0] = 0xF0;
+			memcpy(sysex + 1, msg, length - 1);
+			byte checksum = 0;
+			for (uint16 i = 4; i < length - 1; i++)
+				checksum += msg[i];
+			sysex[length] = (128 - (checksum & 0x7F)) & 0x7F;
+			sysex[length + 1] = 0xF7;
+
+			Common::StackLock lock(_mutex);
+			_service.playSysexAt(sysex, length + 2, getEventTimestamp());
+			delete[] sysex;
+		} else if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
 			Common::StackLock lock(_mutex);
 			_service.writeSysex(msg[1], msg + 4, length - 5);
 		} else {
@@ -268,11 +364,22 @@ void MidiDriver_MT32::close() {
 		return;
 	_isOpen = false;
 
+	// Stop rendering ahead. Once the timer proc is removed it is
+	// guaranteed to not be running anymore.
+	if (_ringBuffer) {
+		g_system->getTimerManager()->removeTimerProc(&renderAheadTimerProc);
+		if (_underruns)
+			debug(1, "MT-32 emulator render-ahead buffer ran empty %u times", _underruns);
+	}
+
 	// Detach the player callback handler
 	setTimerCallback(nullptr, nullptr);
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	delete[] _ringBuffer;
+	_ringBuffer = nullptr;
+
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
 	_service.freeContext();
@@ -287,6 +394,71 @@ void MidiDriver_MT32::generateSamples(int16 *data, int len) {
 	_service.renderBit16s(data, len);
 }
 
+int MidiDriver_MT32::readBuffer(int16 *data, const int numSamples) {
+	if (!_ringBuffer)
+		return MidiDriver_Emulated::readBuffer(data, numSamples);
+
+	// Only copy out what has been rendered ahead. Rendering here instead
+	// would race with the timer callback, so play silence on underruns.
+	uint32 frames = numSamples / 2;
+	uint32 copied = 0;
+	{
+		Common::StackLock lock(_ringMutex);
+
+		while (copied < frames && _ringFill) {
+			uint32 count = MIN(MIN(frames - copied, _ringFill), _ringSize - _ringRead);
+			memcpy(data + copied * 2, _ringBuffer + _ringRead * 2, count * 2 * sizeof(int16));
+
+			copied += count;
+			_ringFill -= count;
+			_ringRead = (_ringRead + count) % _ringSize;
+		}
+	}
+
+	if (copied < frames) {
+		memset(data + copied * 2, 0, (frames - copied) * 2 * sizeof(int16));
+		_underruns++;
+	}
+
+	return numSamples;
+}
+
+void MidiDriver_MT32::renderAheadTimerProc(void *refCon) {
+	MidiDriver_MT32 *driver = (MidiDriver_MT32 *)refCon;
+	driver->renderAhead(driver->_renderAheadStep);
+}
+
+void MidiDriver_MT32::renderAhead(uint32 maxFrames) {
+	int16 chunk[kRenderAheadChunk * 2];
+
+	for (uint32 rendered = 0; rendered < maxFrames; rendered += kRenderAheadChunk) {
+		uint32 writePos;
+		{
+			Common::StackLock lock(_ringMutex);
+			if (_ringFill >= _ringTarget)
+				return;
+
+			writePos = (_ringRead + _ringFill) % _ringSize;
+		}
+
+		// Render without holding the ring lock, since music timer callbacks
+		// are invoked from here and may take a while.
+		MidiDriver_Emulated::readBuffer(chunk, kRenderAheadChunk * 2);
+
+		// Only the timer callback writes to the ring, so the free space
+		// can only have grown in the meantime.
+		Common::StackLock lock(_ringMutex);
+		for (uint32 copied = 0; copied < kRenderAheadChunk; ) {
+			uint32 count = MIN(kRenderAheadChunk - copied, _ringSize - writePos);
+			memcpy(_ringBuffer + writePos * 2, chunk + copied * 2, count * 2 * sizeof(int16));
+
+			copied += count;
+			writePos = (writePos + count) % _ringSize;
+		}
+		_ringFill += kRenderAheadChunk;
+	}
+}
+
 uint32 MidiDriver_MT32::property(int prop, uint32 param) {
 	switch (prop) {
 	case PROP_CHANNEL_MASK:
@@ -37,6 +37,10 @@ static const Bit32u PROCESS_DELAY = 1;
 static const Bit32u MODE_3_ADDITIONAL_DELAY = 1;
 static const Bit32u MODE_3_FEEDBACK_DELAY = 1;
 
+// Number of samples passed through each stage of the reverb at once. The stages have no feedback between them,
+// so the input can be split into blocks of any size.
+static const Bit32u BLOCK_SIZE = 128;
+
 // Avoid denormals degrading performance, using biased input
 static const FloatSample BIAS = 1e-20f;
 
@@ -341,6 +345,29 @@ public:
 		// return buffer output + feedforward / 2
 		return bufferOut + halveSample(this->buffer[this->index]);
 	}
+
+	// Same as above for a block of samples, processed in place. Since the feedback is delayed by the full buffer size,
+	// consecutive samples up to the buffer end are independent and the inner loop can be vectorised by the compiler.
+	void process(Sample *inOut, Bit32u count) {
+		while (count > 0) {
+			Bit32u pos = this->index + 1;
+			if (pos >= this->size) {
+				pos = 0;
+			}
+			const Bit32u run = count < this->size - pos ? count : this->size - pos;
+			Sample *buf = this->buffer + pos;
+
+			for (Bit32u i = 0; i < run; i++) {
+				const Sample bufferOut = buf[i];
+				buf[i] = inOut[i] - halveSample(bufferOut);
+				inOut[i] = bufferOut + halveSample(buf[i]);
+			}
+
+			this->index = pos + run - 1;
+			inOut += run;
+			count -= run;
+		}
+	}
 };
 
 template <class Sample>
@@ -365,8 +392,9 @@ public:
 		this->buffer[this->index] = weirdMul(last, filterFactor, 0xC0) - filterIn;
 	}
 
+	// outIndex must not exceed the buffer size
 	Sample getOutputAt(const Bit32u outIndex) const {
-		return this->buffer[(this->size + this->index - outIndex) % this->size];
+		return this->buffer[this->index >= outIndex ? this->index - outIndex : this->size + this->index - outIndex];
 	}
 
 	void setFeedbackFactor(const Bit8u useFeedbackFactor) {
@@ -565,20 +593,15 @@ public:
 			return;
 		}
 
-		while ((numSamples--) > 0) {
-			Sample dry;
+		if (tapDelayMode) {
+			TapDelayCombFilter<Sample> *comb = static_cast<TapDelayCombFilter<Sample> *>(*combs);
 
-			if (tapDelayMode) {
-				dry = halveSample(*(inLeft++)) + halveSample(*(inRight++));
-			} else {
-				dry = quarterSample(*(inLeft++)) + quarterSample(*(inRight++));
-			}
+			while ((numSamples--) > 0) {
+				Sample dry = halveSample(*(inLeft++)) + halveSample(*(inRight++));
 
-			// Looks like dryAmp doesn't change in MT-32 but it does in CM-32L / LAPC-I
-			dry = weirdMul(addDCBias(dry), dryAmp, 0xFF);
+				// Looks like dryAmp doesn't change in MT-32 but it does in CM-32L / LAPC-I
+				dry = weirdMul(addDCBias(dry), dryAmp, 0xFF);
 
-			if (tapDelayMode) {
-				TapDelayCombFilter<Sample> *comb = static_cast<TapDelayCombFilter<Sample> *>(*combs);
 				comb->process(dry);
 				if (outLeft != NULL) {
 					*(outLeft++) = weirdMul(comb->getLeftOutput(), wetLevel, 0xFF);
@@ -586,24 +609,40 @@ public:
 				if (outRight != NULL) {
 					*(outRight++) = weirdMul(comb->getRightOutput(), wetLevel, 0xFF);
 				}
-			} else {
-				DelayWithLowPassFilter<Sample> * const entranceDelay = static_cast<DelayWithLowPassFilter<Sample> *>(combs[0]);
+			}
+			return;
+		}
+
+		DelayWithLowPassFilter<Sample> * const entranceDelay = static_cast<DelayWithLowPassFilter<Sample> *>(combs[0]);
+		Sample link[BLOCK_SIZE];
+
+		while (numSamples > 0) {
+			const Bit32u blockSize = numSamples < BLOCK_SIZE ? numSamples : BLOCK_SIZE;
+
+			for (Bit32u i = 0; i < blockSize; i++) {
+				Sample dry = quarterSample(*(inLeft++)) + quarterSample(*(inRight++));
+
+				// Looks like dryAmp doesn't change in MT-32 but it does in CM-32L / LAPC-I
+				dry = weirdMul(addDCBias(dry), dryAmp, 0xFF);
+
 				// If the output position is equal to the comb size, get it now in order not to lose it
-				Sample link = entranceDelay->getOutputAt(currentSettings.combSizes[0] - 1);
+				link[i] = addAllpassNoise(entranceDelay->getOutputAt(currentSettings.combSizes[0] - 1));
 
 				// Entrance LPF. Note, comb.process() differs a bit here.
 				entranceDelay->process(dry);
+			}
 
-				link = allpasses[0]->process(addAllpassNoise(link));
-				link = allpasses[1]->process(link);
-				link = allpasses[2]->process(link);
+			allpasses[0]->process(link, blockSize);
+			allpasses[1]->process(link, blockSize);
+			allpasses[2]->process(link, blockSize);
 
+			for (Bit32u i = 0; i < blockSize; i++) {
 				// If the output position is equal to the comb size, get it now in order not to lose it
 				Sample outL1 = combs[1]->getOutputAt(currentSettings.outLPositions[0] - 1);
 
-				combs[1]->process(link);
-				combs[2]->process(link);
-				combs[3]->process(link);
+				combs[1]->process(link[i]);
+				combs[2]->process(link[i]);
+				combs[3]->process(link[i]);
 
 				if (outLeft != NULL) {
 					Sample outL2 = combs[2]->getOutputAt(currentSettings.outLPositions[1]);
@@ -618,8 +657,10 @@ public:
 					Sample outSample = mixCombs(outR1, outR2, outR3);
 					*(outRight++) = weirdMul(outSample, wetLevel, 0xFF);
 				}
-			} // if (tapDelayMode)
-		} // while ((numSamples--) > 0)
+			}
+
+			numSamples -= blockSize;
+		}
 	} // produceOutput
 
 	bool process(const IntSample *inLeft, const IntSample *inRight, IntSample *outLeft, IntSample *outRight, Bit32u numSamples);
@@ -1540,10 +1540,26 @@ void OPL3_Generate4ChStream(opl3_chip *chip, int16_t *sndptr1, int16_t *sndptr2,
 void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples)
 {
     uint_fast32_t i;
+    int32_t rateratio = chip->rateratio;
 
+    /* Same as calling OPL3_GenerateResampled() for each sample, but only
+       the two front channels are interpolated and written directly */
     for(i = 0; i < numsamples; i++)
     {
-        OPL3_GenerateResampled(chip, sndptr);
+        while (chip->samplecnt >= rateratio)
+        {
+            chip->oldsamples[0] = chip->samples[0];
+            chip->oldsamples[1] = chip->samples[1];
+            chip->oldsamples[2] = chip->samples[2];
+            chip->oldsamples[3] = chip->samples[3];
+            OPL3_Generate4Ch(chip, chip->samples);
+            chip->samplecnt -= rateratio;
+        }
+        sndptr[0] = (int16_t)((chip->oldsamples[0] * (rateratio - chip->samplecnt)
+                              + chip->samples[0] * chip->samplecnt) / rateratio);
+        sndptr[1] = (int16_t)((chip->oldsamples[1] * (rateratio - chip->samplecnt)
+                              + chip->samples[1] * chip->samplecnt) / rateratio);
+        chip->samplecnt += 1 << RSM_FRAC;
         sndptr += 2;
     }
 }
@@ -1643,7 +1659,7 @@ void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 }
 
 void OPL::generateSamples(int16*buffer, int length) {
-	OPL3_GenerateStream(&chip, (int16_t*)buffer, (uint16_t)length / 2);
+	OPL3_GenerateStream(&chip, (int16_t*)buffer, (uint32_t)length / 2);
 }
 
 }
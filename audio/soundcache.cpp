@@ -0,0 +1,237 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/soundcache.h"
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+
+#include "common/memstream.h"
+#include "common/mutex.h"
+
+namespace Audio {
+
+/**
+ * Decoded PCM data shared by the cache and the streams playing it.
+ *
+ * The reference count is protected by a mutex, since streams are usually
+ * destroyed by the mixer thread while the cache is used by the engine.
+ */
+class SoundCache::Sound {
+public:
+	Sound(int16 *data, uint32 size, int rate, bool stereo) :
+		_data(data), _size(size), _rate(rate), _stereo(stereo), _refCount(1) {}
+
+	void incRef() {
+		Common::StackLock lock(_mutex);
+		_refCount++;
+	}
+
+	void decRef() {
+		bool last;
+		{
+			Common::StackLock lock(_mutex);
+			last = (--_refCount == 0);
+		}
+
+		if (last)
+			delete this;
+	}
+
+	bool isShared() {
+		Common::StackLock lock(_mutex);
+		return _refCount > 1;
+	}
+
+	const int16 *getData() const { return _data; }
+	uint32 getSize() const { return _size; }
+	int getRate() const { return _rate; }
+	bool isStereo() const { return _stereo; }
+
+private:
+	~Sound() { free(_data); }
+
+	int16 *_data;
+	const uint32 _size;
+	const int _rate;
+	const bool _stereo;
+
+	Common::Mutex _mutex;
+	int _refCount;
+};
+
+/** A memory stream holding a reference on the cached sound it reads. */
+class SoundCache::SoundReadStream : public Common::MemoryReadStream {
+public:
+	SoundReadStream(Sound *sound) :
+		Common::MemoryReadStream((const byte *)sound->getData(), sound->getSize(), DisposeAfterUse::NO), _sound(sound) {
+		_sound->incRef();
+	}
+
+	~SoundReadStream() { _sound->decRef(); }
+
+private:
+	Sound *_sound;
+};
+
+SoundCache::SoundCache(uint32 maxBytes) :
+		_maxBytes(maxBytes), _usedBytes(0), _hits(0), _misses(0), _evictions(0) {
+}
+
+SoundCache::~SoundCache() {
+	clear();
+}
+
+SeekableAudioStream *SoundCache::makeStream(const Common::String &key) {
+	EntryMap::iterator it = _map.find(key);
+	if (it == _map.end()) {
+		_misses++;
+		return nullptr;
+	}
+
+	_hits++;
+
+	// Move the entry to the front of the LRU list
+	EntryList::iterator entry = it->_value;
+	if (entry != _entries.begin()) {
+		_entries.push_front(*entry);
+		_entries.erase(entry);
+		it->_value = _entries.begin();
+	}
+
+	return makeStream(_entries.front().sound);
+}
+
+SeekableAudioStream *SoundCache::insert(const Common::String &key, SeekableAudioStream *stream) {
+	assert(stream);
+
+	const int rate = stream->getRate();
+	const bool stereo = stream->isStereo();
+
+	// Start with the advertised length and grow the buffer for streams
+	// which turn out to be longer
+	uint32 capacity = convertTimeToStreamPos(stream->getLength(), rate, stereo).totalNumberOfFrames();
+	capacity = MAX<uint32>(capacity, 2048);
+
+	int16 *data = (int16 *)malloc(capacity * sizeof(int16));
+	uint32 samples = 0;
+	while (data && !stream->endOfData()) {
+		if (samples == capacity) {
+			capacity *= 2;
+			int16 *grown = (int16 *)realloc(data, capacity * sizeof(int16));
+			if (!grown) {
+				free(data);
+				data = nullptr;
+				break;
+			}
+			data = grown;
+		}
+
+		const int read = stream->readBuffer(data + samples, capacity - samples);
+		if (read <= 0)
+			break;
+		samples += read;
+	}
+
+	delete stream;
+
+	if (!data) {
+		warning("SoundCache: Out of memory while decoding '%s'", key.c_str());
+		return nullptr;
+	}
+
+	// Give back the unused space, so the budget matches the memory held
+	if (samples && samples < capacity) {
+		int16 *shrunk = (int16 *)realloc(data, samples * sizeof(int16));
+		if (shrunk)
+			data = shrunk;
+	}
+
+	return insert(key, data, samples * sizeof(int16), rate, stereo);
+}
+
+SeekableAudioStream *SoundCache::insert(const Common::String &key, int16 *data, uint32 size, int rate, bool stereo) {
+	assert(data);
+
+	EntryMap::iterator it = _map.find(key);
+	if (it != _map.end())
+		remove(it->_value);
+
+	Sound *sound = new Sound(data, size, rate, stereo);
+	_entries.push_front(Entry(key, sound));
+	_map[key] = _entries.begin();
+	_usedBytes += sound->getSize();
+
+	// Create the stream before evicting, so the new sound is not dropped
+	// right away when it alone exceeds the budget
+	SeekableAudioStream *result = makeStream(sound);
+	evict();
+
+	return result;
+}
+
+void SoundCache::clear() {
+	while (!_entries.empty())
+		remove(_entries.begin());
+}
+
+void SoundCache::setMaxBytes(uint32 maxBytes) {
+	_maxBytes = maxBytes;
+	evict();
+}
+
+SeekableAudioStream *SoundCache::makeStream(Sound *sound) {
+	byte flags = FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= FLAG_LITTLE_ENDIAN;
+#endif
+	if (sound->isStereo())
+		flags |= FLAG_STEREO;
+
+	return makeRawStream(new SoundReadStream(sound), sound->getRate(), flags);
+}
+
+void SoundCache::remove(EntryList::iterator entry) {
+	_usedBytes -= entry->sound->getSize();
+	entry->sound->decRef();
+	_map.erase(entry->key);
+	_entries.erase(entry);
+}
+
+void SoundCache::evict() {
+	if (_usedBytes <= _maxBytes)
+		return;
+
+	// Walk from the least recently used entry, skipping the sounds which
+	// are still being played.
+	EntryList::iterator entry = _entries.end();
+	while (_usedBytes > _maxBytes && entry != _entries.begin()) {
+		--entry;
+
+		if (entry->sound->isShared())
+			continue;
+
+		EntryList::iterator victim = entry++;
+		remove(victim);
+		_evictions++;
+	}
+}
+
+} // End of namespace Audio
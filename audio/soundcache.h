@@ -0,0 +1,155 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_SOUNDCACHE_H
+#define AUDIO_SOUNDCACHE_H
+
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_soundcache Decoded sound cache
+ * @ingroup audio
+ *
+ * @brief Cache for short sounds which are decoded over and over again.
+ * @{
+ */
+
+class SeekableAudioStream;
+
+/**
+ * A byte-budgeted cache of decoded sounds.
+ *
+ * Engines which create a new compressed stream each time a short effect is
+ * played can decode it once with insert(), and afterwards create streams
+ * playing the 16-bit PCM data kept in the cache with makeStream(). Sounds are
+ * identified by a key chosen by the caller, usually derived from the resource
+ * the sound was loaded from.
+ *
+ * The returned streams share the cached data and keep it alive on their own,
+ * so they may outlive their cache entry or the cache itself. They can safely
+ * be destroyed by the mixer thread.
+ *
+ * When the total size of the cached sounds exceeds the budget, the least
+ * recently used sounds are evicted. Sounds which are still being played are
+ * never evicted, but their memory only counts as long as they are part of
+ * the cache.
+ */
+class SoundCache : Common::NonCopyable {
+public:
+	/**
+	 * Create a new cache.
+	 *
+	 * @param maxBytes The budget for the PCM data of all cached sounds.
+	 */
+	explicit SoundCache(uint32 maxBytes);
+	~SoundCache();
+
+	/**
+	 * Look up a cached sound and mark it as most recently used.
+	 *
+	 * @return A new stream playing the cached sound, or 0 if it is not
+	 *         cached.
+	 */
+	SeekableAudioStream *makeStream(const Common::String &key);
+
+	/**
+	 * Decode a stream completely and add it to the cache, replacing any
+	 * sound with the same key.
+	 *
+	 * @param key    The key to cache the sound under.
+	 * @param stream The stream to decode, which is deleted afterwards.
+	 * @return A new stream playing the decoded sound from the start.
+	 */
+	SeekableAudioStream *insert(const Common::String &key, SeekableAudioStream *stream);
+
+	/**
+	 * Add already decoded sound data to the cache, replacing any sound with
+	 * the same key.
+	 *
+	 * @param key    The key to cache the sound under.
+	 * @param data   The native endian 16-bit samples, allocated with
+	 *               malloc(). The cache takes ownership of them.
+	 * @param size   The size of the data in bytes.
+	 * @param rate   The sample rate of the sound.
+	 * @param stereo Whether the samples are interleaved stereo.
+	 * @return A new stream playing the sound from the start.
+	 */
+	SeekableAudioStream *insert(const Common::String &key, int16 *data, uint32 size, int rate, bool stereo);
+
+	/** Remove all sounds from the cache. */
+	void clear();
+
+	/** Change the budget, evicting sounds if necessary. */
+	void setMaxBytes(uint32 maxBytes);
+	uint32 getMaxBytes() const { return _maxBytes; }
+
+	/** Return the size of the PCM data of all cached sounds. */
+	uint32 getUsedBytes() const { return _usedBytes; }
+	/** Return the number of cached sounds. */
+	uint getCount() const { return _entries.size(); }
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getEvictions() const { return _evictions; }
+	void resetStats() { _hits = _misses = _evictions = 0; }
+
+private:
+	class Sound;
+	class SoundReadStream;
+
+	struct Entry {
+		Common::String key;
+		Sound *sound;
+
+		Entry(const Common::String &k, Sound *s) : key(k), sound(s) {}
+	};
+
+	/** All entries, the most recently used one first. */
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Common::String, EntryList::iterator> EntryMap;
+
+	EntryList _entries;
+	EntryMap _map;
+
+	uint32 _maxBytes;
+	uint32 _usedBytes;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+
+	static SeekableAudioStream *makeStream(Sound *sound);
+
+	void remove(EntryList::iterator entry);
+	void evict();
+};
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -200,25 +200,26 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	bind();
 
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundaries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
+	// We would like to only upload the dirty area itself. This requires
+	// specifying the source pitch through GL_UNPACK_ROW_LENGTH, which is
+	// available on desktop OpenGL and OpenGL ES 3.0 (or with the
+	// GL_EXT_unpack_subimage extension). This matters a lot for videos which
+	// are played back in a part of a larger game screen: only the video
+	// rectangle is sent to the GPU instead of the full screen width.
 	//
-	// 1) (As we do right now) Simply always update the whole texture lines of
-	//    rect changed. This is simplest to implement. In case performance is
-	//    really an issue we can think of switching to another method.
-	//
-	// 2) Copy the dirty rect to a temporary buffer and upload that by using
-	//    glTexSubImage2D. This is what the Android backend does. It is more
-	//    complicated though.
-	//
-	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
-	//    graphics manager did but it is much slower! Thus, we do not use it.
-	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
-	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	// When GL_UNPACK_ROW_LENGTH is not available (e.g. plain OpenGL ES 1.0
+	// and 2.0) we simply always update the whole texture lines of the rect
+	// changed. Using glTexSubImage2D per line changed, which is what the old
+	// OpenGL graphics manager did, is much slower. Thus, we do not use it.
+	if (OpenGLContext.unpackSubImageSupported && area.width() != src.w) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                       _glFormat, _glType, src.getBasePtr(area.left, area.top)));
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+	} else {
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
+		                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	}
 }
 
 //
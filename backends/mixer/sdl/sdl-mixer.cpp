@@ -186,7 +186,14 @@ SDL_AudioSpec SdlMixerManager::getAudioSpec(uint32 outputRate) {
 
 	memset(&desired, 0, sizeof(desired));
 	desired.freq = freq;
-	desired.format = AUDIO_S16SYS;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// Let the mixer produce float samples directly, skipping the clipping
+	// of the intermediate 16-bit mix
+	if (ConfMan.hasKey("audio_float_output") && ConfMan.getBool("audio_float_output"))
+		desired.format = AUDIO_F32SYS;
+	else
+#endif
+		desired.format = AUDIO_S16SYS;
 	desired.channels = channels;
 	desired.samples = roundDownPowerOfTwo(samples);
 	desired.callback = sdlCallback;
@@ -202,6 +209,12 @@ void SdlMixerManager::startAudio() {
 
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (_obtained.format == AUDIO_F32SYS) {
+		_mixer->mixCallback((float *)samples, len / sizeof(float));
+		return;
+	}
+#endif
 	_mixer->mixCallback(samples, len);
 }
 
@@ -21,6 +21,7 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -33,50 +34,113 @@ struct TimerSlot {
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
-	TimerSlot *next;
+	uint32 order;	// insertion order, for timers firing at the same time
+	uint heapIndex;
+	bool removed;	// removed while its callback was running
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
-};
-
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+	// Statistics
+	uint32 calls;
+	uint32 maxLatency;	// in milliseconds
+	uint32 overruns;	// number of times the timer fell behind by a full interval
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0),
+		order(0), heapIndex(0), removed(false), calls(0), maxLatency(0), overruns(0) {}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+	bool firesBefore(const TimerSlot *other) const {
+		if (nextFireTime != other->nextFireTime)
+			return nextFireTime < other->nextFireTime;
+		return order < other->order;
 	}
+};
+
+static void printTimerStats(const TimerSlot *slot) {
+	debug(2, "Timer '%s' (%d us): %u calls, %u ms max latency, %u overruns",
+	      slot->id.c_str(), slot->interval, slot->calls, slot->maxLatency, slot->overruns);
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
 	_timerCallbackNext(0),
-	_head(nullptr) {
-
-	_head = new TimerSlot();
+	_runningSlot(nullptr),
+	_nextOrder(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
-	Common::StackLock lock(_mutex);
+	_mutex.lock();
+
+	// Stop the handler from firing any more timers. A callback which is
+	// running right now keeps its slot, which the handler deletes.
+	for (uint i = 0; i < _heap.size(); i++) {
+		if (_heap[i] == _runningSlot)
+			_heap[i]->removed = true;
+		else
+			delete _heap[i];
+	}
+	_heap.clear();
+
+	// Wait for the running callback to return before the members it
+	// still uses go away
+	while (_runningSlot) {
+		_mutex.unlock();
+		_callbackMutex.lock();
+		_callbackMutex.unlock();
+		_mutex.lock();
+	}
+
+	_mutex.unlock();
+}
+
+void DefaultTimerManager::heapSet(uint index, TimerSlot *slot) {
+	_heap[index] = slot;
+	slot->heapIndex = index;
+}
+
+void DefaultTimerManager::heapSiftUp(uint index) {
+	TimerSlot *slot = _heap[index];
+	while (index > 0) {
+		uint parent = (index - 1) / 2;
+		if (!slot->firesBefore(_heap[parent]))
+			break;
+		heapSet(index, _heap[parent]);
+		index = parent;
+	}
+	heapSet(index, slot);
+}
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+void DefaultTimerManager::heapSiftDown(uint index) {
+	TimerSlot *slot = _heap[index];
+	const uint size = _heap.size();
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && _heap[child + 1]->firesBefore(_heap[child]))
+			child++;
+		if (!_heap[child]->firesBefore(slot))
+			break;
+		heapSet(index, _heap[child]);
+		index = child;
 	}
-	_head = nullptr;
+	heapSet(index, slot);
+}
+
+void DefaultTimerManager::heapPush(TimerSlot *slot) {
+	slot->order = _nextOrder++;
+	_heap.push_back(slot);
+	heapSiftUp(_heap.size() - 1);
+}
+
+void DefaultTimerManager::heapRemove(uint index) {
+	TimerSlot *last = _heap.back();
+	_heap.pop_back();
+	if (index == _heap.size())
+		return;
+
+	heapSet(index, last);
+	if (index > 0 && last->firesBefore(_heap[(index - 1) / 2]))
+		heapSiftUp(index);
+	else
+		heapSiftDown(index);
 }
 
 void DefaultTimerManager::handler() {
@@ -84,18 +148,15 @@ void DefaultTimerManager::handler() {
 
 	uint32 curTime = g_system->getMillis(true);
 
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
-
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
+	while (!_heap.empty() && _heap[0]->nextFireTime < curTime) {
+		TimerSlot *slot = _heap[0];
 
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+		slot->calls++;
+		slot->maxLatency = MAX(slot->maxLatency, curTime - slot->nextFireTime);
+
+		// Update the fire time and move the TimerSlot to its new place in
+		// the priority queue.
 		assert(slot->interval > 0);
 		slot->nextFireTime += (slot->interval / 1000);
 		slot->nextFireTimeMicro += (slot->interval % 1000);
@@ -103,14 +164,30 @@ void DefaultTimerManager::handler() {
 			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
 			slot->nextFireTimeMicro %= 1000;
 		}
-		insertPrioQueue(_head, slot);
-
-		// Invoke the timer callback
+		if (slot->nextFireTime < curTime)
+			slot->overruns++;
+		slot->order = _nextOrder++;
+		heapSiftDown(0);
+
+		// Invoke the timer callback without holding the scheduler lock.
+		// Taking the callback lock first makes sure a removeTimerProc()
+		// call from another thread waits for the callback to finish.
 		assert(slot->callback);
+		_runningSlot = slot;
+		_callbackMutex.lock();
+		_mutex.unlock();
+
 		slot->callback(slot->refCon);
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+		_callbackMutex.unlock();
+		_mutex.lock();
+		_runningSlot = nullptr;
+
+		// The timer may have removed itself
+		if (slot->removed) {
+			printTimerStats(slot);
+			delete slot;
+		}
 	}
 }
 
@@ -149,42 +226,60 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->interval = interval;
 	slot->nextFireTime = g_system->getMillis() + interval / 1000;
 	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
 
-	insertPrioQueue(_head, slot);
+	heapPush(slot);
 
 	return true;
 }
 
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
-	Common::StackLock lock(_mutex);
-
-	TimerSlot *slot = _head;
+	bool wasRunning = false;
+
+	{
+		Common::StackLock lock(_mutex);
+
+		for (uint i = 0; i < _heap.size(); ) {
+			TimerSlot *slot = _heap[i];
+			if (slot->callback != callback) {
+				i++;
+				continue;
+			}
+
+			heapRemove(i);
+			if (slot == _runningSlot) {
+				// The handler deletes the slot once the callback returns
+				slot->removed = true;
+				wasRunning = true;
+			} else {
+				printTimerStats(slot);
+				delete slot;
+			}
+			// The last slot has been moved to this index, so look at it again
+		}
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
+		// We need to remove all names referencing the timer proc here.
+		//
+		// Else we run into troubles, when the client code removes and readds timer
+		// callbacks.
+		//
+		// Another issues occurs when one plays a game with ALSA as music driver,
+		// returns to launcher and starts a different engine game with ALSA as music driver.
+		// In this case the MPU401 code will add different timer procs with the
+		// same name, resulting in two different callbacks added with the same
+		// name and causing installTimerProc to error out.
+		// A good test case is running a SCUMM with ALSA output and then a KYRA
+		// game for example.
+		for (TimerSlotMap::iterator i = _callbacks.begin(), end = _callbacks.end(); i != end; ++i) {
+			if (i->_value == callback)
+				_callbacks.erase(i);
 		}
 	}
 
-	// We need to remove all names referencing the timer proc here.
-	//
-	// Else we run into troubles, when the client code removes and readds timer
-	// callbacks.
-	//
-	// Another issues occurs when one plays a game with ALSA as music driver,
-	// returns to launcher and starts a different engine game with ALSA as music driver.
-	// In this case the MPU401 code will add different timer procs with the
-	// same name, resulting in two different callbacks added with the same
-	// name and causing installTimerProc to error out.
-	// A good test case is running a SCUMM with ALSA output and then a KYRA
-	// game for example.
-	for (TimerSlotMap::iterator i = _callbacks.begin(), end = _callbacks.end(); i != end; ++i) {
-		if (i->_value == callback)
-			_callbacks.erase(i);
+	// Callers rely on the callback not running anymore once this returns.
+	// When called from the callback itself, the lock is already held by
+	// this thread and this returns immediately.
+	if (wasRunning) {
+		_callbackMutex.lock();
+		_callbackMutex.unlock();
 	}
 }
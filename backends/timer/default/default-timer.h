@@ -22,6 +22,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -33,12 +34,32 @@ class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
+	/**
+	 * Protects the scheduler state. It is not held while callbacks run,
+	 * so timers can be installed and removed without waiting for them.
+	 */
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+
+	/**
+	 * Held while a callback runs, so removeTimerProc() can wait for the
+	 * removed callback to finish.
+	 */
+	Common::Mutex _callbackMutex;
+
+	/** Binary min-heap of the scheduled timers, ordered by fire time */
+	Common::Array<TimerSlot *> _heap;
+	TimerSlot *_runningSlot;
+	uint32 _nextOrder;
 	TimerSlotMap _callbacks;
 
 	uint32 _timerCallbackNext;
 
+	void heapPush(TimerSlot *slot);
+	void heapRemove(uint index);
+	void heapSiftUp(uint index);
+	void heapSiftDown(uint index);
+	void heapSet(uint index, TimerSlot *slot);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
@@ -101,6 +101,7 @@ void MusicPlayer::playSMF(int track, bool loop) {
 		syncVolume();
 
 		_isLooping = loop;
+		startRenderCache(_midiData, midiMusicSize);
 		_isPlaying = true;
 		_track = track;
 		debugC(2, kDraciSoundDebugLevel, "Playing track %d", track);
@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -77,7 +78,8 @@ static int parse_reg_t(EngineState *s, const char *str, reg_t *dest);
 
 Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_engine(engine), _debugState(engine->_debugState), _videoFrameDelay(0),
-	_gameFlagsGlobal(_engine->_features->getGameFlagsGlobal()) {
+	_gameFlagsGlobal(_engine->_features->getGameFlagsGlobal()),
+	_scriptStepsBase(0), _scriptStepsTime(0) {
 
 	assert(_engine);
 	assert(_engine->_gamestate);
@@ -148,6 +150,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
 	registerCmd("visible_plane_items", WRAP_METHOD(Console, cmdVisiblePlaneItemList));
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
 	// Segments
@@ -233,6 +236,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("selector_cache",	WRAP_METHOD(Console, cmdSelectorCache));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -384,6 +388,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_list / vpl - Shows a list of all the planes in the visible draw list (SCI2+)\n");
 	debugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
+	debugPrintf(" cel_cache - Shows statistics of the cel cache, or changes its size (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
 	debugPrintf("\n");
@@ -447,6 +452,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" selector_cache - Shows statistics of the selector lookup cache\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -2245,6 +2251,41 @@ bool Console::cmdVisiblePlaneItemList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	CelCache &cache = CelObj::getCache();
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		cache.resetStats();
+	} else if (argc == 3 && !scumm_stricmp(argv[1], "size")) {
+		int size;
+		if (!parseInteger(argv[2], size) || size < 1) {
+			debugPrintf("Invalid cache size\n");
+			return true;
+		}
+		cache.setMaxSize(size);
+	} else if (argc > 1) {
+		debugPrintf("Shows statistics of the cel cache, or changes its size.\n");
+		debugPrintf("Usage: %s [reset | size <number of cels>]\n", argv[0]);
+		debugPrintf("'reset' clears the statistics\n");
+		return true;
+	}
+
+	const uint hits = cache.getHits();
+	const uint lookups = hits + cache.getMisses();
+	debugPrintf("Cached cels: %u of %u\n", cache.size(), cache.getMaxSize());
+	debugPrintf("Cel lookups: %u, cache hits: %u (%u%%), evictions: %u\n", lookups, hits, lookups ? (uint)((uint64)hits * 100 / lookups) : 0, cache.getEvictions());
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdSavedBits(int argc, const char **argv) {
 	SegManager *segman = _engine->_gamestate->_segMan;
 	SegmentId id = segman->findSegmentByType(SEG_TYPE_HUNK);
@@ -3436,7 +3477,46 @@ bool Console::cmdViewAccumulatorObject(int argc, const char **argv) {
 }
 
 bool Console::cmdScriptSteps(int argc, const char **argv) {
-	debugPrintf("Number of executed SCI operations: %d\n", _engine->_gamestate->scriptStepCounter);
+	const int steps = _engine->_gamestate->scriptStepCounter;
+	const uint32 now = g_system->getMillis();
+
+	if (argc > 1) {
+		if (scumm_stricmp(argv[1], "reset")) {
+			debugPrintf("Shows the number of executed SCI operations.\n");
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+			debugPrintf("'reset' starts measuring the operations per second from now on\n");
+			return true;
+		}
+		_scriptStepsBase = steps;
+		_scriptStepsTime = now;
+	}
+
+	debugPrintf("Number of executed SCI operations: %d\n", steps);
+	if (_scriptStepsTime && now > _scriptStepsTime) {
+		const uint32 elapsed = now - _scriptStepsTime;
+		debugPrintf("%d operations in %u ms since reset, %u operations per second\n",
+			steps - _scriptStepsBase, elapsed, (uint32)((uint64)(steps - _scriptStepsBase) * 1000 / elapsed));
+	}
+	return true;
+}
+
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+
+	if (argc > 1) {
+		if (scumm_stricmp(argv[1], "reset")) {
+			debugPrintf("Shows statistics of the selector lookup cache.\n");
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+			debugPrintf("'reset' clears the statistics\n");
+			return true;
+		}
+		cache.resetStats();
+	}
+
+	const uint32 hits = cache.getHits();
+	const uint32 lookups = hits + cache.getMisses();
+	debugPrintf("Selector lookups: %u, cache hits: %u (%u%%)\n", lookups, hits, lookups ? (uint32)((uint64)hits * 100 / lookups) : 0);
+	debugPrintf("Selector comparisons saved by the cache: %llu\n", (unsigned long long)cache.getSavedComparisons());
 	return true;
 }
 
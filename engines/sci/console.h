@@ -101,6 +101,7 @@ private:
 	bool cmdVisiblePlaneList(int argc, const char **argv);
 	bool cmdPlaneItemList(int argc, const char **argv);
 	bool cmdVisiblePlaneItemList(int argc, const char **argv);
+	bool cmdCelCache(int argc, const char **argv);
 	bool cmdSavedBits(int argc, const char **argv);
 	bool cmdShowSavedBits(int argc, const char **argv);
 	// Segments
@@ -160,6 +161,7 @@ private:
 	bool cmdBreakpointAddress(int argc, const char **argv);
 	// VM
 	bool cmdScriptSteps(int argc, const char **argv);
+	bool cmdSelectorCache(int argc, const char **argv);
 	bool cmdScriptObjects(int argc, const char **argv);
 	bool cmdScriptStrings(int argc, const char **argv);
 	bool cmdScriptSaid(int argc, const char **argv);
@@ -218,6 +220,8 @@ private:
 	Common::Path _videoFile;
 	int _videoFrameDelay;
 	uint16 _gameFlagsGlobal;
+	int _scriptStepsBase; ///< Operation count when script_steps was last reset
+	uint32 _scriptStepsTime; ///< Time when script_steps was last reset, 0 if never
 };
 
 } // End of namespace Sci
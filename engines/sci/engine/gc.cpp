@@ -21,6 +21,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -53,12 +54,13 @@ void WorklistManager::push(reg_t reg) {
 	if (!reg.getSegment()) // No numbers
 		return;
 
-	debugC(kDebugLevelGC, "[GC] Adding %04x:%04x", PRINT_REG(reg));
+	debugC(2, kDebugLevelGC, "[GC] Adding %04x:%04x", PRINT_REG(reg));
 
-	if (_map.contains(reg))
+	bool &known = _map.getOrCreateVal(reg);
+	if (known)
 		return; // already dealt with it
 
-	_map.setVal(reg, true);
+	known = true;
 	_worklist.push_back(reg);
 }
 
@@ -89,7 +91,7 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 		reg_t reg = wm._worklist.back();
 		wm._worklist.pop_back();
 		if (reg.getSegment() != stackSegment) { // No need to repeat this one
-			debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
+			debugC(2, kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
 			if (reg.getSegment() < heap.size() && heap[reg.getSegment()]) {
 				// Valid heap object? Find its outgoing references!
 				wm.pushArray(heap[reg.getSegment()]->listAllOutgoingReferences(reg));
@@ -122,7 +124,7 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	for (reg_t *pos = s->stack_base; pos < sp; pos++)
 		wm.push(*pos);
 
-	debugC(kDebugLevelGC, "[GC] -- Finished adding value stack");
+	debugC(2, kDebugLevelGC, "[GC] -- Finished adding value stack");
 
 	// Init: Execution Stack
 	for (iter = s->_executionStack.begin();
@@ -137,7 +139,7 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 		}
 	}
 
-	debugC(kDebugLevelGC, "[GC] -- Finished adding execution stack");
+	debugC(2, kDebugLevelGC, "[GC] -- Finished adding execution stack");
 
 	const Common::Array<SegmentObj *> &heap = s->_segMan->getSegments();
 	uint heapSize = heap.size();
@@ -168,7 +170,7 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 		}
 	}
 
-	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
+	debugC(2, kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
 
 	processWorkList(s->_segMan, wm, heap);
 
@@ -182,7 +184,10 @@ void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
 
 	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
+	debugC(2, kDebugLevelGC, "[GC] Running...");
+	const uint32 startTime = g_system->getMillis();
+	const uint allocations = segMan->getAllocationsSinceGC();
+	uint freed = 0;
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
@@ -213,7 +218,8 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
-					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					debugC(2, kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					freed++;
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -225,6 +231,13 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	segMan->resetAllocationsSinceGC();
+
+	const uint32 endTime = g_system->getMillis();
+	debugC(kDebugLevelGC, "[GC] Freed %u of %u entries allocated since the last run %u ms ago, paused for %u ms",
+		freed, allocations, s->lastGCTime ? startTime - s->lastGCTime : 0, endTime - startTime);
+	s->lastGCTime = endTime;
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -116,10 +116,20 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// A* set membership
+	bool inOpenSet;
+	bool inClosedSet;
+
+	// Index in the visibility graph, or -1 for vertices without edges
+	int graphIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		inOpenSet = false;
+		inClosedSet = false;
+		graphIndex = -1;
 	}
 };
 
@@ -241,6 +251,40 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * Visibility between the vertices of a polygon set which have edges.
+ * Whether two such vertices can see each other only depends on the
+ * locations of all vertices with edges and their neighbours, which are
+ * stored in the signature. The graph can thus be reused by any later
+ * pathfinding call with an identical signature. Rows are filled in when
+ * first needed.
+ */
+struct VisibilityGraph {
+	enum {
+		kMaxCached = 8 ///< Number of graphs kept in EngineState
+	};
+
+	Common::Array<int16> signature;
+	uint size;
+	Common::Array<bool> rowKnown;
+	Common::Array<uint32> visible; ///< size rows of (size + 31) / 32 words
+
+	VisibilityGraph(const Common::Array<int16> &sig, uint n) : signature(sig), size(n) {
+		rowKnown.resize(n);
+		visible.resize(n * getRowWords());
+	}
+
+	uint getRowWords() const { return (size + 31) / 32; }
+
+	bool isVisible(uint from, uint to) const {
+		return visible[from * getRowWords() + to / 32] & (1u << (to % 32));
+	}
+
+	void setVisible(uint from, uint to) {
+		visible[from * getRowWords() + to / 32] |= (1u << (to % 32));
+	}
+};
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -262,7 +306,13 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Visibility graph of the vertices with edges, indexed by
+	// Vertex::graphIndex
+	VisibilityGraph *graph;
+	Common::Array<Vertex *> graphVertices;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
+		graph = nullptr;
 		vertex_start = nullptr;
 		vertex_end = nullptr;
 		vertex_index = nullptr;
@@ -698,6 +748,39 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether two vertices can see each other.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the first vertex
+ * @param vertex		the second vertex
+ * @return true if the line between the vertices doesn't intersect a polygon
+ */
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -705,39 +788,80 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  * @return list of vertices that are visible from vert
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
+	VisibilityGraph *graph = s->graph;
+	const int from = vertex_cur->graphIndex;
+
+	if (from >= 0 && !graph->rowKnown[from]) {
+		for (uint to = 0; to < graph->size; to++) {
+			if (is_visible(s, vertex_cur, s->graphVertices[to]))
+				graph->setVisible(from, to);
+		}
+		graph->rowKnown[from] = true;
+	}
+
 	VertexList *visVerts = new VertexList();
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
+		bool visible;
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
+		if (from >= 0 && vertex->graphIndex >= 0)
+			visible = graph->isVisible(from, vertex->graphIndex);
+		else
+			visible = is_visible(s, vertex_cur, vertex);
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
+		if (visible)
+			visVerts->push_front(vertex);
+	}
 
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+	return visVerts;
+}
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+/**
+ * Sets up the visibility graph of the pathfinding state, reusing a graph
+ * of an earlier call if its polygon set was identical.
+ * @param es	the engine state, which keeps recently used graphs
+ * @param s		the pathfinding state
+ */
+static void find_visibility_graph(EngineState *es, PathfindingState *s) {
+	Common::Array<int16> signature;
+
+	for (int i = 0; i < s->vertices; i++) {
+		Vertex *vertex = s->vertex_index[i];
+
+		if (VERTEX_HAS_EDGES(vertex)) {
+			vertex->graphIndex = s->graphVertices.size();
+			s->graphVertices.push_back(vertex);
+
+			signature.push_back(vertex->v.x);
+			signature.push_back(vertex->v.y);
+			signature.push_back(CLIST_PREV(vertex)->v.x);
+			signature.push_back(CLIST_PREV(vertex)->v.y);
+			signature.push_back(CLIST_NEXT(vertex)->v.x);
+			signature.push_back(CLIST_NEXT(vertex)->v.y);
 		}
+	}
 
-		if (j == s->vertices)
-			visVerts->push_front(vertex);
+	Common::List<Common::SharedPtr<VisibilityGraph> > &graphs = es->_visibilityGraphs;
+
+	for (Common::List<Common::SharedPtr<VisibilityGraph> >::iterator it = graphs.begin(); it != graphs.end(); ++it) {
+		if ((*it)->signature == signature) {
+			debugC(kDebugLevelAvoidPath, "[avoidpath] Reusing visibility graph of %d vertices", s->graphVertices.size());
+			s->graph = it->get();
+
+			// Move it to the front, as the most recently used graph
+			if (it != graphs.begin()) {
+				graphs.push_front(*it);
+				graphs.erase(it);
+			}
+			return;
+		}
 	}
 
-	return visVerts;
+	graphs.push_front(Common::SharedPtr<VisibilityGraph>(new VisibilityGraph(signature, s->graphVertices.size())));
+	if (graphs.size() > VisibilityGraph::kMaxCached)
+		graphs.pop_back();
+	s->graph = graphs.front().get();
 }
 
 /**
@@ -1360,13 +1484,11 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
-
 	// The remaining vertices
 	VertexList openSet;
 
 	openSet.push_front(s->vertex_start);
+	s->vertex_start->inOpenSet = true;
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
 
@@ -1392,8 +1514,9 @@ static void AStar(PathfindingState *s) {
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
+		vertex_min->inClosedSet = true;
 		openSet.erase(vertex_min_it);
+		vertex_min->inOpenSet = false;
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
 
@@ -1401,11 +1524,13 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->inClosedSet)
 				continue;
 
-			if (!openSet.contains(vertex))
+			if (!vertex->inOpenSet) {
 				openSet.push_front(vertex);
+				vertex->inOpenSet = true;
+			}
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1628,6 +1753,8 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			return output;
 		}
 
+		find_visibility_graph(s, p);
+
 		// Apply Dijkstra
 		AStar(p);
 
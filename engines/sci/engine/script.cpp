@@ -70,12 +70,46 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_markedAsDeleted = false;
 	_objects.clear();
 
+	invalidateInstructionCache();
+
 	_offsetLookupArray.clear();
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
 }
 
+void Script::invalidateInstructionCache() {
+	_instructionIndex.clear();
+	_instructions.clear();
+}
+
+const PMachineInstruction &Script::decodeInstruction(uint32 offset) {
+	if (_instructionIndex.empty())
+		_instructionIndex.resize(_buf->size());
+
+	PMachineInstruction instruction;
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.params);
+
+	// Resolving lofsa/lofss targets may require searching the relocation
+	// table (SCI3), so do it once here
+	const byte opcode = instruction.extOpcode >> 1;
+	if (opcode == op_lofsa || opcode == op_lofss)
+		instruction.lofsOffset = findOffset(instruction.params[0], this, offset + instruction.size);
+	else
+		instruction.lofsOffset = 0;
+
+	// The index only has room for 65535 instructions, which is more than any
+	// known script contains
+	if (offset >= _instructionIndex.size() || _instructions.size() >= 0xFFFF) {
+		_uncachedInstruction = instruction;
+		return _uncachedInstruction;
+	}
+
+	_instructions.push_back(instruction);
+	_instructionIndex[offset] = _instructions.size();
+	return _instructions.back();
+}
+
 enum {
 	kSci11NumExportsOffset = 6,
 	kSci11ExportTableOffset = 8
@@ -93,6 +93,10 @@ private:
 
 	ObjMap _objects;	/**< Table for objects, contains property variables */
 
+	Common::Array<uint16> _instructionIndex; /**< For each byte of _buf, the 1-based index of the instruction starting there in _instructions, or 0 */
+	Common::Array<PMachineInstruction> _instructions; /**< Instructions decoded so far */
+	PMachineInstruction _uncachedInstruction; /**< Used once _instructions can't be indexed any further */
+
 protected:
 	offsetLookupArrayType _offsetLookupArray; // Table of all elements of currently loaded script, that may get pointed to
 
@@ -126,6 +130,28 @@ public:
 	ObjMap &getObjectMap() { return _objects; }
 	const ObjMap &getObjectMap() const { return _objects; }
 
+	/**
+	 * Returns the decoded instruction starting at the given offset. Each
+	 * instruction is decoded once and then served from a cache, which lives
+	 * until the script is freed or invalidateInstructionCache() is called.
+	 * The returned reference is only valid until the next call.
+	 */
+	const PMachineInstruction &getInstruction(uint32 offset) {
+		// speed optimization: inline due to frequent calling
+		if (offset < _instructionIndex.size()) {
+			const uint16 index = _instructionIndex[offset];
+			if (index)
+				return _instructions[index - 1];
+		}
+		return decodeInstruction(offset);
+	}
+
+	/**
+	 * Drops all cached instructions. Must be called whenever the code in the
+	 * script buffer is modified after it has been executed.
+	 */
+	void invalidateInstructionCache();
+
 	// speed optimization: inline due to frequent calling
 	bool offsetIsObject(uint32 offset) const {
 		return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
@@ -300,6 +326,12 @@ public:
 	uint32 getRelocationOffset(const uint32 offset) const;
 
 private:
+	/**
+	 * Decodes the instruction at the given offset and adds it to the
+	 * instruction cache.
+	 */
+	const PMachineInstruction &decodeInstruction(uint32 offset);
+
 	/**
 	 * Returns a Span containing the relocation table for a SCI0-SCI2.1 script.
 	 * (The SCI0-SCI2.1 relocation table is simply a list of all of the
@@ -39,6 +39,8 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_nodesSegId = 0;
 	_hunksSegId = 0;
 
+	_allocationsSinceGC = 0;
+
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
@@ -79,6 +81,11 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	_selectorLookupCache.invalidate();
+
+	// Make sure that the next garbage collection runs, e.g. after restoring
+	_allocationsSinceGC = 1;
 }
 
 void SegManager::initSysStrings() {
@@ -180,6 +187,9 @@ void SegManager::deallocate(SegmentId seg) {
 
 	delete mobj;
 	_heap[actualSegment] = nullptr;
+
+	// Objects in the segment are gone, and its ID may be reused
+	_selectorLookupCache.invalidate();
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -459,6 +469,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	}
 
 	int offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk &h = table->at(offset);
@@ -491,9 +502,17 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 	}
 
+	// Freed entries are reused before the table grows
+	const bool reused = (table->first_free != CloneTable::HEAPENTRY_INVALID);
 	int offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_clonesSegId, offset);
+
+	// The entry held a different clone before
+	if (reused)
+		_selectorLookupCache.invalidateObject(*addr);
+
 	return &table->at(offset);
 }
 
@@ -508,6 +527,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -524,6 +544,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -950,6 +971,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 	}
 
 	int offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -1006,6 +1028,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	int offset = table->allocEntry();
+	++_allocationsSinceGC;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1100,12 +1123,16 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	}
 
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
+	_resMan->prefetchScriptResources(scriptNum);
 	scr->initializeLocals(this);
 	scr->initializeObjects(this, segmentId, applyScriptPatches);
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
 
+	// New objects and classes are available now
+	_selectorLookupCache.invalidate();
+
 	return segmentId;
 }
 
@@ -1136,6 +1163,8 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		// Let the garbage collector free the script
+		++_allocationsSinceGC;
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -28,6 +28,7 @@
 #include "sci/engine/vm.h"
 #include "sci/engine/vm_types.h"
 #include "sci/engine/segment.h"
+#include "sci/engine/selector.h"
 #ifdef ENABLE_SCI32
 #include "sci/graphics/celobj32.h" // kLowResX, kLowResY
 #endif
@@ -460,6 +461,21 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Returns the cache used by lookupSelector(). It is invalidated whenever
+	 * scripts are instantiated, segments are deallocated or clones are
+	 * allocated.
+	 */
+	SelectorLookupCache &getSelectorLookupCache() { return _selectorLookupCache; }
+
+	/**
+	 * Returns the number of entries allocated in clone, hunk, list, node,
+	 * array and bitmap segments, plus the number of scripts marked as
+	 * deleted, since the last garbage collection.
+	 */
+	uint getAllocationsSinceGC() const { return _allocationsSinceGC; }
+	void resetAllocationsSinceGC() { _allocationsSinceGC = 0; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -469,6 +485,9 @@ private:
 	ResourceManager *_resMan;
 	ScriptPatcher *_scriptPatcher;
 
+	SelectorLookupCache _selectorLookupCache;
+	uint _allocationsSinceGC;
+
 	SegmentId _clonesSegId; ///< ID of the (a) clones segment
 	SegmentId _listsSegId; ///< ID of the (a) list segment
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
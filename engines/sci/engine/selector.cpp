@@ -323,6 +323,35 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
+SelectorLookupCache::SelectorLookupCache() : _generation(1) {
+	memset(_entries, 0, sizeof(_entries));
+	resetStats();
+}
+
+void SelectorLookupCache::invalidate() {
+	++_generation;
+	if (_generation == 0) {
+		// The generation wrapped around, so old entries could become valid
+		// again
+		memset(_entries, 0, sizeof(_entries));
+		_generation = 1;
+	}
+}
+
+void SelectorLookupCache::invalidateObject(reg_t obj) {
+	// The entries of an object are spread over the whole table by the hash
+	for (uint i = 0; i < kSize; ++i) {
+		if (_entries[i].obj == obj)
+			_entries[i].generation = 0;
+	}
+}
+
+void SelectorLookupCache::resetStats() {
+	_hits = 0;
+	_misses = 0;
+	_savedComparisons = 0;
+}
+
 SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
 	const Object *obj = segMan->getObject(obj_location);
 	int index;
@@ -337,34 +366,53 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
 	}
 
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	SelectorLookupCache::Entry &entry = cache.getEntry(obj_location, selectorId);
+	if (cache.isValid(entry, obj_location, selectorId)) {
+		cache.recordHit(entry);
+		if (entry.type == kSelectorVariable) {
+			if (varp) {
+				varp->obj = obj_location;
+				varp->varindex = entry.varIndex;
+			}
+		} else if (entry.type == kSelectorMethod) {
+			if (fptr)
+				*fptr = entry.func;
+		}
+		return entry.type;
+	}
+
+	entry.type = kSelectorNone;
+	entry.cost = obj->getVarCount();
 	index = obj->locateVarSelector(segMan, selectorId);
 
 	if (index >= 0) {
 		// Found it as a variable
+		entry.type = kSelectorVariable;
+		entry.varIndex = index;
 		if (varp) {
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
-		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
 		while (obj) {
+			entry.cost += obj->getMethodCount();
 			index = obj->funcSelectorPosition(selectorId);
 			if (index >= 0) {
+				entry.type = kSelectorMethod;
+				entry.func = obj->getFunction(index);
 				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
+					*fptr = entry.func;
+				break;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
 			}
 		}
-
-		return kSelectorNone;
 	}
 
-
-//	return _lookupSelector_function(segMan, obj, selectorId, fptr);
+	cache.store(entry, obj_location, selectorId);
+	return entry.type;
 }
 
 } // End of namespace Sci
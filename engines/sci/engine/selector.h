@@ -208,6 +208,82 @@ struct SelectorCache {
  */
 #define SELECTOR(_slc_)		(g_sci->getKernel()->_selectorCache._slc_)
 
+/**
+ * Caches the results of lookupSelector(), which otherwise searches the
+ * variables of the object's class and the methods of every class in its
+ * superclass chain. Entries are keyed by object and selector, and are
+ * dropped as a whole by invalidate() whenever objects may have been
+ * created, moved or destroyed.
+ */
+class SelectorLookupCache {
+public:
+	struct Entry {
+		uint32 generation; ///< The generation the entry was stored in, 0 if unused
+		reg_t obj;
+		Selector selector;
+		SelectorType type;
+		int varIndex;
+		reg_t func;
+		uint cost; ///< Number of selectors compared by the uncached lookup
+	};
+
+	SelectorLookupCache();
+
+	/**
+	 * Returns the entry for the given object and selector. The entry is
+	 * only valid if isValid() returns true for it, otherwise it may be
+	 * filled by the caller and passed to store().
+	 */
+	Entry &getEntry(reg_t obj, Selector selector) {
+		const uint32 hash = (obj.getSegment() * 0x9E3779B1) ^ (obj.getOffset() * 0x85EBCA6B) ^ selector;
+		return _entries[(hash ^ (hash >> 16)) & (kSize - 1)];
+	}
+
+	bool isValid(const Entry &entry, reg_t obj, Selector selector) const {
+		return entry.generation == _generation && entry.obj == obj && entry.selector == selector;
+	}
+
+	void store(Entry &entry, reg_t obj, Selector selector) {
+		entry.generation = _generation;
+		entry.obj = obj;
+		entry.selector = selector;
+		++_misses;
+	}
+
+	void recordHit(const Entry &entry) {
+		++_hits;
+		_savedComparisons += entry.cost;
+	}
+
+	/**
+	 * Drops all entries.
+	 */
+	void invalidate();
+
+	/**
+	 * Drops the entries of a single object, e.g. when its address is reused
+	 * for a different object.
+	 */
+	void invalidateObject(reg_t obj);
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint64 getSavedComparisons() const { return _savedComparisons; }
+	void resetStats();
+
+private:
+	enum {
+		kSize = 2048 ///< Number of entries, must be a power of two
+	};
+
+	Entry _entries[kSize];
+	uint32 _generation;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint64 _savedComparisons;
+};
+
 /**
  * Retrieves a selector from an object.
  * @param segMan	the segment mananger
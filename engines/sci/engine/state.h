@@ -24,6 +24,8 @@
 
 #include "common/scummsys.h"
 #include "common/array.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/serializer.h"
 #include "common/str-array.h"
 
@@ -48,6 +50,7 @@ class EventManager;
 class MessageState;
 class SoundCommandParser;
 class VirtualIndexFile;
+struct VisibilityGraph;
 
 enum AbortGameState {
 	kAbortNone = 0,
@@ -188,6 +191,7 @@ struct EngineState : public Common::Serializable {
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	uint32 lastGCTime; /**< Time at which the last gc finished, for debug output */
 
 	MessageState *_msgState;
 
@@ -199,6 +203,12 @@ struct EngineState : public Common::Serializable {
 	uint16 _memorySegmentSize;
 	byte _memorySegment[kMemorySegmentMax];
 
+	/**
+	 * Visibility graphs of the polygon sets recently used by kAvoidPath,
+	 * most recently used first.
+	 */
+	Common::List<Common::SharedPtr<VisibilityGraph> > _visibilityGraphs;
+
 	/**
 	 * Resets the engine state.
 	 */
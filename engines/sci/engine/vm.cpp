@@ -543,7 +543,6 @@ void run_vm(EngineState *s) {
 	int temp;
 	reg_t r_temp; // Temporary register
 	StackPtr s_temp; // Temporary stack pointer
-	int16 opparams[4]; // opcode parameters
 
 	s->r_rest = 0;	// &rest adjusts the parameter count by this value
 	// Current execution data:
@@ -620,9 +619,12 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		// Get opcode. The instruction is copied, as nested calls of run_vm()
+		// may decode further instructions of the same script.
+		const PMachineInstruction instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+		const int16 *opparams = instruction.params;
+		const byte extOpcode = instruction.extOpcode;
+		s->xs->addr.pc.incOffset(instruction.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -847,10 +849,13 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
+			// Run the garbage collector, if needed. Without any allocations
+			// since the last run, memory usage can't have grown, so the
+			// collection is skipped then.
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				if (s->_segMan->getAllocationsSinceGC())
+					run_gc(s);
 			}
 
 			// Call kernel function
@@ -1195,7 +1200,10 @@ void run_vm(EngineState *s) {
 			// Load offset to accumulator or push to stack
 
 			r_temp.setSegment(s->xs->addr.pc.getSegment());
-			r_temp.setOffset(findOffset(opparams[0], local_script, s->xs->addr.pc.getOffset()));
+			if (local_script == scr)
+				r_temp.setOffset(instruction.lofsOffset);
+			else
+				r_temp.setOffset(findOffset(opparams[0], local_script, s->xs->addr.pc.getOffset()));
 			if (r_temp.getOffset() >= scr->getBufSize())
 				error("VM: lofsa/lofss operation overflowed: %04x:%04x beyond end"
 						  " of script (at %04x)", PRINT_REG(r_temp), scr->getBufSize());
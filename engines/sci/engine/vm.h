@@ -415,6 +415,17 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
  */
 int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]);
 
+/**
+ * A PMachine instruction decoded by readPMachineInstruction(), as cached by
+ * Script::getInstruction().
+ */
+struct PMachineInstruction {
+	byte extOpcode;   ///< "extended" opcode, the lowest bit selects byte sized operands
+	uint16 size;      ///< length in bytes of the instruction
+	int16 params[4];  ///< parameters of the instruction
+	uint32 lofsOffset; ///< resolved target of lofsa/lofss, see findOffset()
+};
+
 /**
  * Finds the script-absolute offset of a relative object offset.
  *
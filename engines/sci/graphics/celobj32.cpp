@@ -88,9 +88,8 @@ bool CelObj::_drawBlackLines = false;
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
-	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+	_cache = new CelCache(500);
 }
 
 void CelObj::deinit() {
@@ -139,13 +138,22 @@ struct SCALER_NoScale {
 		}
 	}
 
-	inline byte read() {
-		assert(_row != _rowEdge);
-
+	/**
+	 * Reads the next `width` source pixels of the current row. Unflipped
+	 * rows are returned in place, flipped rows are copied to `buffer`.
+	 */
+	inline const byte *readRow(byte *buffer, const int16 width) {
 		if (FLIP) {
-			return *_row--;
+			assert(_row - width >= _rowEdge);
+			for (int16 x = 0; x < width; ++x) {
+				buffer[x] = *_row--;
+			}
+			return buffer;
 		} else {
-			return *_row++;
+			assert(_row + width <= _rowEdge);
+			const byte *row = _row;
+			_row += width;
+			return row;
 		}
 	}
 };
@@ -300,9 +308,18 @@ struct SCALER_Scale {
 		assert(_x >= _minX && _x <= _maxX);
 	}
 
-	inline byte read() {
-		assert(_x >= _minX && _x <= _maxX);
-		return _row[_valuesX[_x++]];
+	/**
+	 * Reads the next `width` scaled source pixels of the current row into
+	 * `buffer`.
+	 */
+	inline const byte *readRow(byte *buffer, const int16 width) {
+		assert(_x >= _minX && _x + width - 1 <= _maxX);
+		const int16 *valuesX = _valuesX + _x;
+		for (int16 x = 0; x < width; ++x) {
+			buffer[x] = _row[valuesX[x]];
+		}
+		_x += width;
+		return buffer;
 	}
 };
 
@@ -463,9 +480,19 @@ inline byte translateMacColor(bool isMacSource, byte color) {
  * remapping data.
  */
 struct MAPPER_NoMD {
-	inline void draw(byte *target, const byte pixel, const uint8 skipColor, const bool isMacSource) const {
-		if (pixel != skipColor) {
-			*target = translateMacColor(isMacSource, pixel);
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		if (isMacSource) {
+			for (int16 x = 0; x < width; ++x) {
+				if (source[x] != skipColor) {
+					target[x] = translateMacColor(true, source[x]);
+				}
+			}
+		} else {
+			// Written without a branch, so that compilers can vectorize it
+			for (int16 x = 0; x < width; ++x) {
+				const byte pixel = source[x];
+				target[x] = pixel != skipColor ? pixel : target[x];
+			}
 		}
 	}
 };
@@ -475,8 +502,14 @@ struct MAPPER_NoMD {
  * no remapping data.
  */
 struct MAPPER_NoMDNoSkip {
-	inline void draw(byte *target, const byte pixel, const uint8, const bool isMacSource) const {
-		*target = translateMacColor(isMacSource, pixel);
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8, const bool isMacSource) const {
+		if (isMacSource) {
+			for (int16 x = 0; x < width; ++x) {
+				target[x] = translateMacColor(true, source[x]);
+			}
+		} else {
+			memcpy(target, source, width);
+		}
 	}
 };
 
@@ -496,6 +529,12 @@ struct MAPPER_Map {
 			}
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		for (int16 x = 0; x < width; ++x) {
+			draw(target + x, source[x], skipColor, isMacSource);
+		}
+	}
 };
 
 /**
@@ -510,6 +549,12 @@ struct MAPPER_NoMap {
 			*target = translateMacColor(isMacSource, pixel);
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		for (int16 x = 0; x < width; ++x) {
+			draw(target + x, source[x], skipColor, isMacSource);
+		}
+	}
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
@@ -686,45 +731,77 @@ void CelObj::submitPalette() const {
 #pragma mark -
 #pragma mark CelObj - Caching
 
-int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
-int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
+CelCache::CelCache(const uint maxSize) :
+	_maxSize(maxSize),
+	_hits(0),
+	_misses(0),
+	_evictions(0) {}
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+CelCache::~CelCache() {
+	clear();
+}
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
-			oldestId = entry.id;
-			oldestIndex = i;
-		}
+const CelObj *CelCache::find(const CelInfo32 &celInfo) {
+	CelMap::iterator it = _map.find(celInfo);
+	if (it == _map.end()) {
+		++_misses;
+		return nullptr;
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
+	++_hits;
+	CelList::iterator cel = it->_value;
+	if (cel != _cels.begin()) {
+		_cels.push_front(*cel);
+		_cels.erase(cel);
+		it->_value = _cels.begin();
+	}
+	return _cels.front();
+}
+
+void CelCache::insert(CelObj *celObj) {
+	CelMap::iterator it = _map.find(celObj->_info);
+	if (it != _map.end()) {
+		delete *it->_value;
+		_cels.erase(it->_value);
+		_map.erase(it);
 	}
 
-	return -1;
+	_cels.push_front(celObj);
+	_map[celObj->_info] = _cels.begin();
+	evict();
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
-		error("Invalid cache index");
+void CelCache::clear() {
+	for (CelList::iterator it = _cels.begin(); it != _cels.end(); ++it) {
+		delete *it;
 	}
+	_cels.clear();
+	_map.clear();
+}
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
-	entry.celObj.reset(duplicate());
-	entry.id = ++_nextCacheId;
+void CelCache::setMaxSize(const uint maxSize) {
+	_maxSize = maxSize;
+	evict();
+}
+
+void CelCache::evict() {
+	while (_cels.size() > _maxSize) {
+		CelObj *celObj = _cels.back();
+		_map.erase(celObj->_info);
+		_cels.pop_back();
+		delete celObj;
+		++_evictions;
+	}
+}
+
+const CelObj *CelObj::searchCache(const CelInfo32 &celInfo) const {
+	return _cache->find(celInfo);
+}
+
+void CelObj::putCopyInCache() const {
+	_cache->insert(duplicate());
 }
 
 #pragma mark -
@@ -745,6 +822,8 @@ struct RENDERER {
 
 	inline void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
 		byte *targetPixel = (byte *)target.getPixels() + target.w * targetRect.top + targetRect.left;
+		byte rowBuffer[kCelScalerTableSize];
+		assert(targetRect.width() <= kCelScalerTableSize);
 
 		const int16 skipStride = target.w - targetRect.width();
 		const int16 targetWidth = targetRect.width();
@@ -758,11 +837,12 @@ struct RENDERER {
 
 			_scaler.setTarget(targetRect.left, targetRect.top + y);
 
-			for (int16 x = 0; x < targetWidth; ++x) {
-				_mapper.draw(targetPixel++, _scaler.read(), _skipColor, _isMacSource);
-			}
+			// Whole rows are read and drawn at once, which lets the common
+			// cases skip per-pixel calls and use memcpy or vector code
+			const byte *sourcePixel = _scaler.readRow(rowBuffer, targetWidth);
+			_mapper.drawRow(targetPixel, sourcePixel, targetWidth, _skipColor, _isMacSource);
 
-			targetPixel += skipStride;
+			targetPixel += targetWidth + skipStride;
 		}
 	}
 };
@@ -971,16 +1051,13 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	_compressionType = kCelCompressionInvalid;
 	_transparent = true;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
+	const CelObj *const cacheEntry = searchCache(_info);
+	if (cacheEntry != nullptr) {
+		const CelObjView *const cachedCelObj = dynamic_cast<const CelObjView *>(cacheEntry);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjView in cache slot %d", cacheIndex);
+			error("Expected a CelObjView in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1078,7 +1155,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		_remap = analyzeForRemap();
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjView::analyzeUncompressedForRemap() const {
@@ -1179,16 +1256,13 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	_transparent = true;
 	_remap = false;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
+	const CelObj *const cacheEntry = searchCache(_info);
+	if (cacheEntry != nullptr) {
+		const CelObjPic *const cachedCelObj = dynamic_cast<const CelObjPic *>(cacheEntry);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjPic in cache slot %d", cacheIndex);
+			error("Expected a CelObjPic in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1252,7 +1326,7 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 		}
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjPic::analyzeUncompressedForSkip() const {
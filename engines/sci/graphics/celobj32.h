@@ -22,6 +22,8 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +107,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +117,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -136,17 +138,76 @@ struct CelInfo32 {
 };
 
 class CelObj;
-struct CelCacheEntry {
+
+/**
+ * A cache of cel objects keyed by their CelInfo32. When the cache is full, the
+ * least recently used cel is replaced.
+ */
+class CelCache {
+public:
+	CelCache(uint maxSize);
+	~CelCache();
+
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * Returns the cached CelObj matching the given CelInfo32 and marks it as
+	 * the most recently used cel, or returns null if there is no such cel.
 	 */
-	int id;
-	Common::ScopedPtr<CelObj> celObj;
-	CelCacheEntry() : id(0) {}
-};
+	const CelObj *find(const CelInfo32 &celInfo);
+
+	/**
+	 * Adds the given CelObj to the cache, taking ownership of it. Any cel with
+	 * the same CelInfo32 is replaced, and the least recently used cels are
+	 * evicted if the cache is full.
+	 */
+	void insert(CelObj *celObj);
+
+	/**
+	 * Removes all cels from the cache.
+	 */
+	void clear();
+
+	/**
+	 * Changes the maximum number of cels held by the cache, evicting cels if
+	 * the cache is now too full.
+	 */
+	void setMaxSize(uint maxSize);
 
-typedef Common::Array<CelCacheEntry> CelCache;
+	uint getMaxSize() const { return _maxSize; }
+	uint size() const { return _cels.size(); }
+
+	uint getHits() const { return _hits; }
+	uint getMisses() const { return _misses; }
+	uint getEvictions() const { return _evictions; }
+	void resetStats() { _hits = _misses = _evictions = 0; }
+
+private:
+	struct CelInfo32_Hash {
+		uint operator()(const CelInfo32 &info) const {
+			return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 8) ^ info.celNo ^ (info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+		}
+	};
+
+	struct CelInfo32_EqualTo {
+		bool operator()(const CelInfo32 &a, const CelInfo32 &b) const {
+			return a == b;
+		}
+	};
+
+	/**
+	 * The cached cels, ordered from most to least recently used.
+	 */
+	typedef Common::List<CelObj *> CelList;
+	typedef Common::HashMap<CelInfo32, CelList::iterator, CelInfo32_Hash, CelInfo32_EqualTo> CelMap;
+
+	void evict();
+
+	CelList _cels;
+	CelMap _map;
+	uint _maxSize;
+	uint _hits;
+	uint _misses;
+	uint _evictions;
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -449,13 +510,13 @@ private:
 
 #pragma mark -
 #pragma mark CelObj - Caching
-protected:
+public:
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * Returns the cel cache, for inspection from the debugger.
 	 */
-	static int _nextCacheId;
+	static CelCache &getCache() { return *_cache; }
 
+protected:
 	/**
 	 * A cache of cel objects used to avoid reinitialisation overhead for cels
 	 * with the same CelInfo32.
@@ -464,16 +525,14 @@ protected:
 
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
+	 * not found, null is returned.
 	 */
-	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
+	const CelObj *searchCache(const CelInfo32 &celInfo) const;
 
 	/**
-	 * Puts a copy of this CelObj into the cache at the given cache index.
+	 * Puts a copy of this CelObj into the cache.
 	 */
-	void putCopyInCache(int index) const;
+	void putCopyInCache() const;
 };
 
 #pragma mark -
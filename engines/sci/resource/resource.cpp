@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -1006,6 +1007,7 @@ void ResourceManager::init() {
 	_memoryLocked = 0;
 	_memoryLRU = 0;
 	_LRU.clear();
+	_prefetchQueue.clear();
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1157,6 +1159,58 @@ void ResourceManager::freeOldResources() {
 	}
 }
 
+void ResourceManager::prefetchResource(ResourceId id) {
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	for (Common::List<ResourceId>::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it) {
+		if (*it == id)
+			return;
+	}
+
+	_prefetchQueue.push_back(id);
+}
+
+void ResourceManager::prefetchScriptResources(uint16 scriptNr) {
+	static const ResourceType types[] = {
+		kResourceTypePic, kResourceTypeView, kResourceTypeSound, kResourceTypeMessage
+	};
+
+	for (int i = 0; i < ARRAYSIZE(types); ++i)
+		prefetchResource(ResourceId(types[i], scriptNr));
+}
+
+bool ResourceManager::processPrefetchQueue(uint32 untilTime) {
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty() && g_system->getMillis() < untilTime) {
+		const ResourceId id = _prefetchQueue.front();
+		_prefetchQueue.pop_front();
+
+		// The resource may have been requested by the game in the meantime
+		Resource *res = testResource(id);
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		loadResource(res);
+		loaded = true;
+
+		if (!res->data() || _memoryLRU + (int)res->size() > _maxMemoryLRU) {
+			// Don't push out resources which are actually in use, and stop
+			// prefetching until the next room
+			res->unalloc();
+			_prefetchQueue.clear();
+			break;
+		}
+
+		addToLRU(res);
+		debugC(kDebugLevelResMan, 2, "[resMan] Prefetched %s (%u bytes)", id.toString().c_str(), res->size());
+	}
+
+	return loaded;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -380,6 +380,31 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Queues a resource to be loaded ahead of its use, the next time the
+	 * engine is idle (see processPrefetchQueue). Requesting a queued resource
+	 * with findResource before then simply loads it immediately.
+	 * @param id	The resource to prefetch
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Queues the pics, views, sounds and messages that share their number
+	 * with the given script, which is the convention used for the resources
+	 * of a room.
+	 * @param scriptNr	The number of the script which was just loaded
+	 */
+	void prefetchScriptResources(uint16 scriptNr);
+
+	/**
+	 * Loads queued resources into the LRU until the queue is empty or the
+	 * given time is reached. Resources are only prefetched while they fit
+	 * into the LRU without evicting anything.
+	 * @param untilTime	The time, in milliseconds, by which to stop
+	 * @return true if any resource was loaded
+	 */
+	bool processPrefetchQueue(uint32 untilTime);
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -501,6 +526,7 @@ protected:
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Common::List<ResourceId> _prefetchQueue; ///< Resources to load when the engine is idle
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
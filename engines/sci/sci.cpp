@@ -1012,7 +1012,9 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		uint32 time = _system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			_system->delayMillis(10);
+			// Use the idle time to load resources the game is about to need
+			if (!_resMan->processPrefetchQueue(time + 10))
+				_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				_system->delayMillis(wakeUpTime - time);
@@ -42,8 +42,14 @@
 
 namespace Sci {
 
+enum {
+	kSoundCacheSize = 4 * 1024 * 1024,
+	/** Longest compressed sound in milliseconds which is cached decoded */
+	kMaxCachedSoundLength = 10 * 1000
+};
+
 AudioPlayer::AudioPlayer(ResourceManager *resMan) : _resMan(resMan), _audioRate(11025),
-		_audioCdStart(0), _initCD(false), _playCounter(0) {
+		_audioCdStart(0), _initCD(false), _playCounter(0), _soundCache(kSoundCacheSize) {
 
 	_mixer = g_system->getMixer();
 	_wPlayFlag = false;
@@ -372,6 +378,13 @@ Audio::RewindableAudioStream *AudioPlayer::getAudioStream(uint32 number, uint32
 
 	*sampleLen = 0;
 
+	const Common::String cacheKey = Common::String::format("%u:%u", volume, number);
+	audioSeekStream = _soundCache.makeStream(cacheKey);
+	if (audioSeekStream) {
+		*sampleLen = (audioSeekStream->getLength().msecs() * 60) / 1000;
+		return audioSeekStream;
+	}
+
 	if (volume == 65535) {
 		audioRes = _resMan->findResource(ResourceId(kResourceTypeAudio, number), false);
 		if (!audioRes) {
@@ -420,6 +433,9 @@ Audio::RewindableAudioStream *AudioPlayer::getAudioStream(uint32 number, uint32
 			error("Compressed audio file encountered, but no decoder compiled in for: '%s'", tag2str(audioCompressionType));
 			break;
 		}
+
+		if (audioSeekStream && audioSeekStream->getLength().msecs() <= kMaxCachedSoundLength)
+			audioSeekStream = _soundCache.insert(cacheKey, audioSeekStream);
 	} else {
 		// Original source file
 		if (audioRes->size() > 6 &&
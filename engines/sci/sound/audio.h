@@ -25,6 +25,7 @@
 
 #include "sci/engine/vm_types.h"
 #include "audio/mixer.h"
+#include "audio/soundcache.h"
 
 namespace Audio {
 class RewindableAudioStream;
@@ -88,6 +89,12 @@ private:
 	bool _wPlayFlag;
 	bool _initCD;
 	uint16 _playCounter;
+
+	/**
+	 * Short compressed sounds (MP3, Ogg Vorbis or FLAC), kept decoded so
+	 * repeated effects and speech lines are only decoded once.
+	 */
+	Audio::SoundCache _soundCache;
 };
 
 } // End of namespace Sci
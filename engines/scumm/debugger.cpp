@@ -79,6 +79,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("box",       WRAP_METHOD(ScummDebugger, Cmd_PrintBox));
 	registerCmd("matrix",    WRAP_METHOD(ScummDebugger, Cmd_PrintBoxMatrix));
 	registerCmd("camera",    WRAP_METHOD(ScummDebugger, Cmd_Camera));
+	registerCmd("strips",    WRAP_METHOD(ScummDebugger, Cmd_Strips));
 	registerCmd("room",      WRAP_METHOD(ScummDebugger, Cmd_Room));
 	registerCmd("objects",   WRAP_METHOD(ScummDebugger, Cmd_PrintObjects));
 	registerCmd("object",    WRAP_METHOD(ScummDebugger, Cmd_Object));
@@ -1072,6 +1073,23 @@ bool ScummDebugger::Cmd_Camera(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Strips(int argc, const char **argv) {
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset")) {
+			debugPrintf("Usage: strips [reset]\n");
+			return true;
+		}
+		_vm->_totalStripsDrawn = _vm->_totalStripsSkipped = 0;
+	}
+
+	const uint32 total = _vm->_totalStripsDrawn + _vm->_totalStripsSkipped;
+	debugPrintf("Dirty strips in the last frame: %u drawn, %u skipped as unchanged\n", _vm->_stripsDrawn, _vm->_stripsSkipped);
+	debugPrintf("Dirty strips in total: %u drawn, %u skipped as unchanged (%u%%)\n", _vm->_totalStripsDrawn, _vm->_totalStripsSkipped,
+		total ? (uint32)((uint64)_vm->_totalStripsSkipped * 100 / total) : 0);
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintBox(int argc, const char **argv) {
 	int num, i = 0;
 
@@ -56,6 +56,7 @@ private:
 	bool Cmd_PrintObjects(int argc, const char **argv);
 	bool Cmd_Actor(int argc, const char **argv);
 	bool Cmd_Camera(int argc, const char **argv);
+	bool Cmd_Strips(int argc, const char **argv);
 	bool Cmd_Object(int argc, const char **argv);
 	bool Cmd_Script(int argc, const char **argv);
 	bool Cmd_PrintScript(int argc, const char **argv);
@@ -527,6 +527,9 @@ void ScummEngine::markRectAsDirty(VirtScreenNumber virt, int left, int right, in
  * code in the backend is controlled from here.
  */
 void ScummEngine::drawDirtyScreenParts() {
+	_stripsDrawn = 0;
+	_stripsSkipped = 0;
+
 	// Update verbs
 	updateDirtyScreen(kVerbVirtScreen);
 
@@ -539,6 +542,7 @@ void ScummEngine::drawDirtyScreenParts() {
 		VirtScreen *vs = &_virtscr[kMainVirtScreen];
 		drawStripToScreen(vs, 0, vs->w, 0, vs->h);
 		vs->setDirtyRange(vs->h, 0);
+		vs->invalidateStripHashes();
 	} else {
 		updateDirtyScreen(kMainVirtScreen);
 	}
@@ -595,6 +599,31 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	int w = 8;
 	int start = 0;
 
+	if (canSkipUnchangedStrips(slot)) {
+		// Scripts often mark strips as dirty which did not actually change.
+		// Those are already on the display, so don't compose, convert and
+		// copy them again.
+		for (i = 0; i < _gdi->_numStrips; i++) {
+			if (!vs->bdirty[i])
+				continue;
+
+			const uint32 hash = hashStrip(vs, i, vs->tdirty[i], vs->bdirty[i]);
+			if (hash != 0 && hash == vs->stripHash[i]) {
+				vs->tdirty[i] = vs->h;
+				vs->bdirty[i] = 0;
+				_stripsSkipped++;
+				_totalStripsSkipped++;
+			} else {
+				vs->stripHash[i] = hash;
+				_stripsDrawn++;
+				_totalStripsDrawn++;
+			}
+		}
+	} else if (slot == kBannerVirtScreen) {
+		// Banners are drawn over the other virtual screens
+		invalidateStripHashes();
+	}
+
 	for (i = 0; i < _gdi->_numStrips; i++) {
 		if (vs->bdirty[i]) {
 			const int top = vs->tdirty[i];
@@ -640,7 +669,7 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 
 	// Some extra vertical alignment for certain render modes. It matters for MI1EGA. The dithering patterns require the alignment,
 	// otherwise there will be visible glitches. It can be found in the original interpreters.
-	int align = (_game.version > 2 && (_renderMode == Common::kRenderCGA || _renderMode == Common::kRenderHercG || _renderMode == Common::kRenderHercA)) ? 4 : (_enableEGADithering ? 2 : 1);
+	int align = getStripRowAlignment();
 	top &= ~(align - 1);
 	if (bottom & (align - 1))
 		bottom = (bottom + align) & ~(align - 1);
@@ -804,6 +833,77 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 	_system->copyRectToScreen(src, pitch, x, y, width, height);
 }
 
+int ScummEngine::getStripRowAlignment() const {
+	return (_game.version > 2 && (_renderMode == Common::kRenderCGA || _renderMode == Common::kRenderHercG || _renderMode == Common::kRenderHercA)) ? 4 : (_enableEGADithering ? 2 : 1);
+}
+
+/**
+ * Returns whether unchanged dirty strips of the given virtual screen can be
+ * skipped. This is limited to the plain drawStripToScreen() path, where the
+ * displayed content of a strip only depends on the virtual screen, the text
+ * surface and the render mode. EGA dithering is excluded, since its color
+ * tables change along with the palette.
+ */
+bool ScummEngine::canSkipUnchangedStrips(VirtScreenNumber slot) const {
+	return slot != kBannerVirtScreen && _game.version < 7 && _game.heversion == 0 &&
+		_game.platform != Common::kPlatformFMTowns && _game.platform != Common::kPlatformNES &&
+		!_macScreen && !_useCJKMode && _textSurfaceMultiplier == 1 && !_enableEGADithering &&
+		_outputPixelFormat.bytesPerPixel == 1;
+}
+
+static inline uint32 mixStripHash(uint32 hash, uint32 value) {
+	return (hash ^ value) * 16777619;
+}
+
+/**
+ * Computes a hash of everything which decides what drawStripToScreen() puts
+ * on the display for a single strip, or returns 0 if the strip can't be
+ * hashed.
+ */
+uint32 ScummEngine::hashStrip(const VirtScreen *vs, int strip, int top, int bottom) const {
+	const int x = strip * 8;
+	if (x + 8 > vs->w)
+		return 0;
+
+	// Use the same rows as drawStripToScreen()
+	const int align = getStripRowAlignment();
+	top &= ~(align - 1);
+	if (bottom & (align - 1))
+		bottom = (bottom + align) & ~(align - 1);
+	if (top < _screenTop)
+		top = _screenTop;
+	if (bottom > _screenTop + _screenHeight)
+		bottom = _screenTop + _screenHeight;
+	if (bottom <= top || bottom > vs->h)
+		return 0;
+
+	uint32 hash = 2166136261U;
+	hash = mixStripHash(hash, strip);
+	hash = mixStripHash(hash, top);
+	hash = mixStripHash(hash, bottom);
+	hash = mixStripHash(hash, vs->xstart);
+	hash = mixStripHash(hash, vs->topline);
+	hash = mixStripHash(hash, _screenTop);
+
+	const byte *src = vs->getPixels(x, top);
+	const byte *text = (const byte *)_textSurface.getBasePtr(x, vs->topline + top - _screenTop);
+	for (int y = top; y < bottom; ++y) {
+		hash = mixStripHash(hash, READ_UINT32(src));
+		hash = mixStripHash(hash, READ_UINT32(src + 4));
+		hash = mixStripHash(hash, READ_UINT32(text));
+		hash = mixStripHash(hash, READ_UINT32(text + 4));
+		src += vs->pitch;
+		text += _textSurface.pitch;
+	}
+
+	return hash ? hash : 1;
+}
+
+void ScummEngine::invalidateStripHashes() {
+	for (int i = 0; i < ARRAYSIZE(_virtscr); i++)
+		_virtscr[i].invalidateStripHashes();
+}
+
 const byte *ScummEngine::postProcessDOSGraphics(VirtScreen *vs, int &pitch, int &x, int &y, int &width, int &height) const {
 	static const byte v2VrbColMap[] =	{ 0x0, 0x5, 0x5, 0x5, 0xA, 0xA, 0xA, 0xF, 0xF, 0x5, 0x5, 0x5, 0xA, 0xA, 0xF, 0xF };
 	static const byte v2TxtColMap[] =	{ 0x0, 0xF, 0xA, 0x5, 0xA, 0x5, 0x5, 0xF, 0xA, 0xA, 0xA, 0xA, 0xA, 0x5, 0x5, 0xF };
@@ -1740,6 +1840,7 @@ void ScummEngine::moveScreen(int dx, int dy, int height) {
 		return;
 	screen->move(dx, dy, height);
 	_system->unlockScreen();
+	invalidateStripHashes();
 }
 
 void ScummEngine_v5::clearFlashlight() {
@@ -4628,6 +4729,9 @@ void ScummEngine::dissolveEffect(int width, int height) {
 	int i;
 	bool canHalt = false;
 	bool is1x1Pattern = (width == 1 && height == 1);
+
+	invalidateStripHashes();
+
 	// There's probably some less memory-hungry way of doing this. But
 	// since we're only dealing with relatively small images, it shouldn't
 	// be too bad.
@@ -4787,6 +4891,8 @@ void ScummEngine::scrollEffect(int dir) {
 	int x, y;
 	const int step = 8;
 
+	invalidateStripHashes();
+
 	// Keep in mind: this effect is only present in v5 and v6, so VAR_FADE_DELAY is
 	// never uninitialized. The following check is here for good measure only.
 	int delay = (VAR_FADE_DELAY != 0xFF) ? VAR(VAR_FADE_DELAY) : (int)kPictureDelay;
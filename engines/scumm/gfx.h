@@ -240,6 +240,14 @@ struct VirtScreen : Graphics::Surface {
 	 */
 	uint16 bdirty[80 + 1];
 
+	/**
+	 * Array containing for each visible strip of this virtual screen a hash
+	 * of the content which was last drawn to the display for that strip, or 0
+	 * if it is unknown. This is used to skip strips which were marked as dirty
+	 * without actually changing.
+	 */
+	uint32 stripHash[80 + 1];
+
 	void clear() {
 		// FIXME: Call Graphics::Surface clear / constructor?
 		number = kMainVirtScreen;
@@ -249,6 +257,16 @@ struct VirtScreen : Graphics::Surface {
 		backBuf = nullptr;
 		for (uint i = 0; i < ARRAYSIZE(tdirty); i++) tdirty[i] = 0;
 		for (uint i = 0; i < ARRAYSIZE(bdirty); i++) bdirty[i] = 0;
+		invalidateStripHashes();
+	}
+
+	/**
+	 * Forgets what was last drawn to the display for every strip. This has to
+	 * be called whenever the display is changed behind updateDirtyScreen's
+	 * back, e.g. by a transition effect.
+	 */
+	void invalidateStripHashes() {
+		for (uint i = 0; i < ARRAYSIZE(stripHash); i++) stripHash[i] = 0;
 	}
 
 	/**
@@ -639,6 +639,99 @@ void ScummEngine::ensureResourceLoaded(ResType type, ResId idx) {
 		VAR(VAR_ROOM_FLAG) = 1;
 }
 
+/**
+ * Queues the costumes, scripts and sounds stored in the given room to be
+ * loaded while the engine is idle, so that they don't have to be read from
+ * disk once the room needs them.
+ */
+void ScummEngine::queueResourcePrefetch(int room) {
+	static const ResType types[] = { rtCostume, rtScript, rtSound };
+
+	_prefetchQueue.clear();
+
+	for (int i = 0; i < ARRAYSIZE(types); i++) {
+		const ResType type = types[i];
+		for (ResId idx = 1; idx < _res->_types[type].size(); idx++) {
+			if (_res->_types[type][idx]._address || getResourceRoomNr(type, idx) != room ||
+				getResourceRoomOffset(type, idx) == RES_INVALID_OFFSET)
+				continue;
+
+			PrefetchRequest request;
+			request.type = type;
+			request.idx = idx;
+			_prefetchQueue.push_back(request);
+		}
+	}
+}
+
+bool ScummEngine::prefetchResources(uint32 untilTime) {
+	// Reading a resource can take a few milliseconds, so don't start
+	// one right before the engine has to continue
+	const uint32 minLoadTime = 3;
+
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty() && _system->getMillis() + minLoadTime <= untilTime) {
+		const PrefetchRequest request = _prefetchQueue.front();
+		_prefetchQueue.pop_front();
+
+		if (_res->isResourceLoaded(request.type, request.idx))
+			continue;
+
+		// Only use free heap space, never expire other resources for this.
+		// A smaller resource later in the queue may still fit.
+		const uint32 size = readResourceSize(request.type, request.idx);
+		if (!size || _res->getHeapSize() + size >= _res->getMaxHeapThreshold())
+			continue;
+
+		ensureResourceLoaded(request.type, request.idx);
+		_res->countPrefetched();
+		loaded = true;
+	}
+
+	return loaded;
+}
+
+/**
+ * Returns the size stored in the header of the given resource in the data
+ * files, or 0 if it cannot be read. Some sounds are converted while they
+ * are loaded, so their size in memory can differ.
+ */
+uint32 ScummEngine::readResourceSize(ResType type, ResId idx) {
+	// The sound threads read from _fileHandle as well
+	Common::StackLock lock(_resourceAccessMutex);
+
+	int roomNr = getResourceRoomNr(type, idx);
+	if (roomNr == 0)
+		roomNr = _roomResource;
+
+	const uint32 fileOffs = getResourceRoomOffset(type, idx);
+	if (fileOffs == RES_INVALID_OFFSET)
+		return 0;
+
+	openRoom(roomNr);
+
+	_fileHandle->seek(fileOffs + _fileOffset, SEEK_SET);
+
+	uint32 size;
+	if (_game.features & GF_OLD_BUNDLE) {
+		size = _fileHandle->readUint16LE();
+	} else if (_game.features & GF_SMALL_HEADER) {
+		if (_game.version == 4)
+			_fileHandle->seek(8, SEEK_CUR);
+		size = _fileHandle->readUint32LE();
+	} else {
+		// Skip the tag
+		_fileHandle->seek(4, SEEK_CUR);
+		size = _fileHandle->readUint32BE();
+	}
+
+	if (_fileHandle->err() || _fileHandle->eos())
+		return 0;
+
+	return size;
+}
+
 int ScummEngine::loadResource(ResType type, ResId idx) {
 	int roomNr;
 	uint32 fileOffs;
@@ -911,6 +1004,9 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_expiredNum = 0;
+	_expiredSize = 0;
+	_prefetchedNum = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -1077,10 +1173,41 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+/**
+ * Returns in which order unused resources of the given type are expired when
+ * the heap runs full. Types with a lower priority are expired first. Sounds
+ * and scripts are cheap to read back, while rooms and charsets are used all
+ * the time and are the most expensive to reload.
+ */
+static int getExpirePriority(ResType type) {
+	switch (type) {
+	case rtSound:
+	case rtScript:
+		return 0;
+	case rtRoom:
+	case rtRoomImage:
+	case rtRoomScripts:
+	case rtCharset:
+		return 2;
+	default:
+		return 1;
+	}
+}
+
+struct ExpireCandidate {
+	ResType type;
+	ResId idx;
+	byte counter;
+	int priority;
+
+	bool operator<(const ExpireCandidate &other) const {
+		if (priority != other.priority)
+			return priority < other.priority;
+		return counter > other.counter;
+	}
+};
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1093,31 +1220,39 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
+	// Collect all resources which may be expired, i.e. which can be reloaded
+	// from the data files and which have not been used since the resource
+	// counters were last increased, and expire them in order of type priority
+	// and age.
+	Common::Array<ExpireCandidate> candidates;
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (_types[type]._mode == kDynamicResTypeMode)
+			continue;
+
+		ResId idx = _types[type].size();
+		while (idx-- > 0) {
+			Resource &tmp = _types[type][idx];
+			byte counter = tmp.getResourceCounter();
+			if (!tmp.isLocked() && counter >= 2 && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+				ExpireCandidate candidate;
+				candidate.type = type;
+				candidate.idx = idx;
+				candidate.counter = counter;
+				candidate.priority = getExpirePriority(type);
+				candidates.push_back(candidate);
 			}
 		}
+	}
 
-		if (!best_type)
+	Common::sort(candidates.begin(), candidates.end());
+
+	for (uint i = 0; i < candidates.size(); ++i) {
+		_expiredSize += _types[candidates[i].type][candidates[i].idx]._size;
+		_expiredNum++;
+		nukeResource(candidates[i].type, candidates[i].idx);
+		if (size + _allocatedSize <= _minHeapThreshold)
 			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+	}
 
 	increaseResourceCounters();
 
@@ -1201,6 +1336,7 @@ void ResourceManager::resourceStats() {
 	}
 
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	debug(1, "Expired %d resources (%d bytes), prefetched %d resources", _expiredNum, _expiredSize, _prefetchedNum);
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
@@ -174,6 +174,12 @@ protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
+	uint32 _expiredNum, _expiredSize;
+
+	/**
+	 * Number of resources loaded ahead of time by ScummEngine::prefetchResources.
+	 */
+	uint32 _prefetchedNum;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -181,6 +187,10 @@ public:
 
 	void setHeapThreshold(int min, int max);
 	uint32 getHeapSize() { return _allocatedSize; }
+	uint32 getMaxHeapThreshold() const { return _maxHeapThreshold; }
+
+	void countPrefetched() { _prefetchedNum++; }
+	uint32 getPrefetchedNum() const { return _prefetchedNum; }
 
 	void allocResTypeData(ResType type, uint32 tag, int num, ResTypeMode mode);
 	void freeResources();
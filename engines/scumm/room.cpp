@@ -190,6 +190,8 @@ void ScummEngine::startScene(int room, Actor *a, int objectNr) {
 	if (_roomResource == 0)
 		return;
 
+	queueResourcePrefetch(_roomResource);
+
 	memset(gfxUsageBits, 0, sizeof(gfxUsageBits));
 
 	if (_game.version >= 5 && a) {
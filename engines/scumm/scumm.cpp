@@ -2559,7 +2559,9 @@ void ScummEngine::waitForTimer(int quarterFrames, bool freezeMacGui) {
 #endif
 		if (cur >= endTime)
 			break;
-		_system->delayMillis(MIN<uint32>(10, endTime - cur));
+		// Use the idle time to load resources of the current room
+		if (!prefetchResources(MIN<uint32>(cur + 10, endTime)))
+			_system->delayMillis(MIN<uint32>(10, endTime - cur));
 	}
 
 	// Set the last wait time as the expected end time, which may be different
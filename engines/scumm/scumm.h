@@ -29,6 +29,7 @@
 #include "common/file.h"
 #include "common/savefile.h"
 #include "common/keyboard.h"
+#include "common/list.h"
 #include "common/mutex.h"
 #include "common/random.h"
 #include "common/rect.h"
@@ -1102,6 +1103,16 @@ public:
 	void ensureResourceLoaded(ResType type, ResId idx);
 
 protected:
+	struct PrefetchRequest {
+		ResType type;
+		ResId idx;
+	};
+	Common::List<PrefetchRequest> _prefetchQueue;
+
+	void queueResourcePrefetch(int room);
+	bool prefetchResources(uint32 untilTime);
+	uint32 readResourceSize(ResType type, ResId idx);
+
 	Common::Mutex _resourceAccessMutex; // Used in getResourceSize(), getResourceAddress() and findResource()
 										// to avoid race conditions between the audio thread of Digital iMUSE
 										// and the main SCUMM thread
@@ -1420,6 +1431,16 @@ protected:
 	virtual void drawDirtyScreenParts();
 	void updateDirtyScreen(VirtScreenNumber slot);
 	void drawStripToScreen(VirtScreen *vs, int x, int width, int top, int bottom);
+	int getStripRowAlignment() const;
+	bool canSkipUnchangedStrips(VirtScreenNumber slot) const;
+	uint32 hashStrip(const VirtScreen *vs, int strip, int top, int bottom) const;
+	void invalidateStripHashes();
+
+	// Dirty strip statistics, for the last frame and since the start
+	uint32 _stripsDrawn = 0;
+	uint32 _stripsSkipped = 0;
+	uint32 _totalStripsDrawn = 0;
+	uint32 _totalStripsSkipped = 0;
 
 	void mac_markScreenAsDirty(int x, int y, int w, int h);
 	void mac_drawStripToScreen(VirtScreen *vs, int top, int x, int y, int width, int height);
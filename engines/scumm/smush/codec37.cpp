@@ -242,19 +242,12 @@ void SmushDeltaBlocksDecoder::makeTable(int pitch, int index) {
 #define READ_LITERAL_PIXEL(src, v) \
 	v = *src++
 
-#define WRITE_4X1_LINE(dst, v)  \
-	do {                        \
-		int j;                  \
-		for (j = 0; j < 4; j++) \
-			(dst)[j] = v;       \
-	} while (0)
+// The compiler turns these into word accesses where the platform allows it
+#define WRITE_4X1_LINE(dst, v) \
+	memset((dst), (v), 4)
 
-#define COPY_4X1_LINE(dst, src)  \
-	do {                         \
-		int j;                   \
-		for (j = 0; j < 4; j++)  \
-			(dst)[j] = (src)[j]; \
-	} while (0)
+#define COPY_4X1_LINE(dst, src) \
+	memcpy((dst), (src), 4)
 
 #else /* SCUMM_NEED_ALIGNMENT */
 
@@ -324,6 +317,27 @@ void SmushDeltaBlocksDecoder::makeTable(int pitch, int index) {
 		dst += 4;                                             \
 	} while (0)
 
+/* Copy a run of unchanged 4x4 pixel blocks from the previous frame, a whole
+ * row of blocks at a time */
+
+#define COPY_4X4_RUN(dst, nextOffs, pitch, length, i, bw, bh)              \
+	do {                                                                   \
+		while (length > 0) {                                               \
+			int32 run = MIN(length, i);                                    \
+			for (int y = 0; y < 4; y++) {                                  \
+				memcpy(dst + pitch * y, dst + nextOffs + pitch * y, run * 4); \
+			}                                                              \
+			dst += run * 4;                                                \
+			length -= run;                                                 \
+			i -= run;                                                      \
+			if (i == 0) {                                                  \
+				dst += pitch * 3;                                          \
+				bh--;                                                      \
+				i = bw;                                                    \
+			}                                                              \
+		}                                                                  \
+	} while (0)
+
 void SmushDeltaBlocksDecoder::proc1(byte *dst, const byte *src, int32 nextOffs, int bw, int bh, int pitch, int16 *offsetTable) {
 	uint8 code;
 	bool filling, skipCode;
@@ -438,16 +452,7 @@ void SmushDeltaBlocksDecoder::proc4WithFDFE(byte *dst, const byte *src, int32 ne
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + nextOffs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				COPY_4X4_RUN(dst, nextOffs, pitch, length, i, bw, bh);
 				if (bh == 0) {
 					return;
 				}
@@ -470,16 +475,7 @@ void SmushDeltaBlocksDecoder::proc4WithoutFDFE(byte *dst, const byte *src, int32
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + nextOffs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				COPY_4X4_RUN(dst, nextOffs, pitch, length, i, bw, bh);
 				if (bh == 0) {
 					return;
 				}
@@ -55,13 +55,18 @@ namespace Scumm {
 
 #endif
 
+// Motion vectors always point into one of the other delta buffers, so the
+// 8x1 copies never overlap. Fixed size memcpy/memset calls are turned into
+// single word accesses by the compiler, which are safe even on platforms that
+// need aligned memory accesses.
+#define COPY_8X1_LINE(dst, src) \
+	memcpy((dst), (src), 8)
+
+#define FILL_8X1_LINE(dst, val) \
+	memset((dst), (val), 8)
+
 #define FILL_4X1_LINE(dst, val) \
-	do {                        \
-		(dst)[0] = val;         \
-		(dst)[1] = val;         \
-		(dst)[2] = val;         \
-		(dst)[3] = val;         \
-	} while (0)
+	memset((dst), (val), 4)
 
 #define FILL_2X1_LINE(dst, val) \
 	do {                        \
@@ -300,6 +305,24 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 			}
 		}
 	}
+
+	// Also keep each glyph as a line by line mask of the pixels drawn in
+	// its first color, which lets level1() and level2() draw whole lines
+	for (i = 0; i < NGLYPHS; i++) {
+		if (sideLength == 8) {
+			const byte *glyph = _tableBig + i * 388;
+			byte *mask = (byte *)(_glyphMasksBig + i * 8);
+			memset(mask, 0, 64);
+			for (x = 0; x < glyph[384]; x++)
+				mask[glyph[256 + x]] = 0xFF;
+		} else {
+			const byte *glyph = _tableSmall + i * 128;
+			byte *mask = (byte *)(_glyphMasksSmall + i * 4);
+			memset(mask, 0, 16);
+			for (x = 0; x < glyph[96]; x++)
+				mask[glyph[64 + x]] = 0xFF;
+		}
+	}
 }
 
 void SmushDeltaGlyphsDecoder::makeCodecTables(int width) {
@@ -425,20 +448,13 @@ void SmushDeltaGlyphsDecoder::level2(byte *d_dst) {
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		byte *tmpPtr = _tableSmall + *_dSrc++ * 128;
-		int32 l = tmpPtr[96];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[97];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
+		const uint32 *mask = _glyphMasksSmall + *_dSrc++ * 4;
+		const uint32 fg = *_dSrc++ * 0x01010101U;
+		const uint32 bg = *_dSrc++ * 0x01010101U;
+		for (i = 0; i < 4; i++) {
+			const uint32 line = (fg & mask[i]) | (bg & ~mask[i]);
+			memcpy(d_dst, &line, 4);
+			d_dst += _dPitch;
 		}
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
@@ -463,8 +479,7 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	if (code < MOTION_OFFSET_TABLE_SIZE) {
 		tmp = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else if (code == PROCESS_SUBBLOCKS) {
@@ -478,39 +493,30 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	} else if (code == FILL_SINGLE_COLOR) {
 		byte t = *_dSrc++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		tmp = *_dSrc++;
-		byte *tmpPtr = _tableBig + tmp * 388;
-		byte l = tmpPtr[384];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[385];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
+		// The two colors of a glyph cover the whole block, so it can be
+		// drawn a line at a time by blending them through the glyph mask
+		const uint64 *mask = _glyphMasksBig + *_dSrc++ * 8;
+		const uint64 fg = *_dSrc++ * 0x0101010101010101ULL;
+		const uint64 bg = *_dSrc++ * 0x0101010101010101ULL;
+		for (i = 0; i < 8; i++) {
+			const uint64 line = (fg & mask[i]) | (bg & ~mask[i]);
+			memcpy(d_dst, &line, 8);
+			d_dst += _dPitch;
 		}
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _dPitch;
 		}
 	}
@@ -541,7 +547,9 @@ SmushDeltaGlyphsDecoder::SmushDeltaGlyphsDecoder(int width, int height) : _prevS
 	_height = height;
 	_tableBig = (byte *)malloc(NGLYPHS * 388);
 	_tableSmall = (byte *)malloc(NGLYPHS * 128);
-	if ((_tableBig != nullptr) && (_tableSmall != nullptr)) {
+	_glyphMasksBig = (uint64 *)malloc(NGLYPHS * 8 * sizeof(uint64));
+	_glyphMasksSmall = (uint32 *)malloc(NGLYPHS * 4 * sizeof(uint32));
+	if ((_tableBig != nullptr) && (_tableSmall != nullptr) && (_glyphMasksBig != nullptr) && (_glyphMasksSmall != nullptr)) {
 		makeTablesInterpolation(4);
 		makeTablesInterpolation(8);
 	}
@@ -563,6 +571,10 @@ SmushDeltaGlyphsDecoder::~SmushDeltaGlyphsDecoder() {
 		free(_tableSmall);
 		_tableSmall = nullptr;
 	}
+	free(_glyphMasksBig);
+	_glyphMasksBig = nullptr;
+	free(_glyphMasksSmall);
+	_glyphMasksSmall = nullptr;
 	_lastTableWidth = -1;
 	if (_deltaBuf) {
 		free(_deltaBuf);
@@ -574,7 +586,7 @@ SmushDeltaGlyphsDecoder::~SmushDeltaGlyphsDecoder() {
 }
 
 bool SmushDeltaGlyphsDecoder::decode(byte *dst, const byte *src) {
-	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_deltaBuf == nullptr))
+	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_glyphMasksBig == nullptr) || (_glyphMasksSmall == nullptr) || (_deltaBuf == nullptr))
 		return false;
 
 	_offset1 = _deltaBufs[1] - _curBuf;
@@ -40,6 +40,8 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	uint64 *_glyphMasksBig;
+	uint32 *_glyphMasksSmall;
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
@@ -48,6 +48,7 @@ BaseImage::BaseImage() {
 	_surface = nullptr;
 	_decoder = nullptr;
 	_deletableSurface = nullptr;
+	_hasAlpha = false;
 }
 
 
@@ -61,12 +62,17 @@ BaseImage::~BaseImage() {
 }
 
 bool BaseImage::loadFile(const Common::String &filename) {
+	Image::PNGDecoder *pngDecoder = nullptr;
 	_filename = filename;
 	_filename.toLowercase();
 	if (filename.hasPrefix("savegame:") || _filename.hasSuffix(".bmp")) {
 		_decoder = new Image::BitmapDecoder();
 	} else if (_filename.hasSuffix(".png")) {
-		_decoder = new Image::PNGDecoder();
+		pngDecoder = new Image::PNGDecoder();
+		if (_outputFormat.bytesPerPixel != 0) {
+			pngDecoder->setOutputPixelFormat(_outputFormat);
+		}
+		_decoder = pngDecoder;
 	} else if (_filename.hasSuffix(".tga")) {
 		_decoder = new Image::TGADecoder();
 	} else if (_filename.hasSuffix(".jpg")) {
@@ -83,11 +89,32 @@ bool BaseImage::loadFile(const Common::String &filename) {
 	_decoder->loadStream(*file);
 	_surface = _decoder->getSurface();
 	_palette = _decoder->getPalette();
+	if (pngDecoder && _surface) {
+		// Take over the pixels, so they can be handed on without a copy
+		_surface = _deletableSurface = pngDecoder->releaseSurface();
+	}
+
+	// PNGs may already be converted to the output format, which can add an
+	// alpha channel the original image didn't have.
+	if (pngDecoder) {
+		_hasAlpha = pngDecoder->hasAlpha();
+	} else {
+		_hasAlpha = _surface && _surface->format.aBits() != 0;
+	}
 	_fileManager->closeFile(file);
 
 	return true;
 }
 
+Graphics::Surface *BaseImage::releaseSurface() {
+	if (!_deletableSurface || _surface != _deletableSurface) {
+		return nullptr;
+	}
+	Graphics::Surface *surface = _deletableSurface;
+	_surface = _deletableSurface = nullptr;
+	return surface;
+}
+
 byte BaseImage::getAlphaAt(int x, int y) const {
 	if (!_surface) {
 		return 0xFF;
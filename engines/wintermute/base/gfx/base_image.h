@@ -48,13 +48,33 @@ public:
 	BaseImage();
 	~BaseImage();
 
+	/**
+	 * Request the pixel format to decode true color images to.
+	 *
+	 * This is a hint: only PNG images are converted while decoding, so
+	 * callers still have to check the format of the returned surface.
+	 * Must be called before loadFile().
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) {
+		_outputFormat = format;
+	}
 	bool loadFile(const Common::String &filename);
 	const Graphics::Surface *getSurface() const {
 		return _surface;
 	};
+	/**
+	 * Hand the image over to the caller, who becomes responsible for freeing
+	 * and deleting it. Returns nullptr if the image is owned by a decoder that
+	 * can't release it, in which case getSurface() has to be copied.
+	 */
+	Graphics::Surface *releaseSurface();
 	const byte *getPalette() const {
 		return _palette;
 	}
+	/** Whether the image file has an alpha channel, whatever the output format. */
+	bool hasAlpha() const {
+		return _hasAlpha;
+	}
 	byte getAlphaAt(int x, int y) const;
 	bool writeBMPToStream(Common::WriteStream *stream) const;
 	bool resize(int newWidth, int newHeight);
@@ -67,6 +87,8 @@ private:
 	const Graphics::Surface *_surface;
 	Graphics::Surface *_deletableSurface;
 	const byte *_palette;
+	Graphics::PixelFormat _outputFormat;
+	bool _hasAlpha;
 	BaseFileManager *_fileManager;
 };
 
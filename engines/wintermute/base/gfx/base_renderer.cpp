@@ -41,8 +41,12 @@
 
 namespace Wintermute {
 
+// Budget for decoded images. Surfaces share the cached images they were loaded
+// from, so images which are in use count too, and are never evicted.
+static const uint32 kImageCacheSize = 32 * 1024 * 1024;
+
 //////////////////////////////////////////////////////////////////////
-BaseRenderer::BaseRenderer(BaseGame *inGame) : BaseClass(inGame) {
+BaseRenderer::BaseRenderer(BaseGame *inGame) : BaseClass(inGame), _imageCache(kImageCacheSize) {
 	_window = 0;
 	_clipperWindow = 0;
 	_active = false;
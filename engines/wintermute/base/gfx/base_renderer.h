@@ -34,6 +34,8 @@
 #include "common/rect.h"
 #include "common/array.h"
 
+#include "image/image_cache.h"
+
 namespace Wintermute {
 
 class BaseImage;
@@ -197,6 +199,9 @@ public:
 
 	int32 getWidth() const { return _width; }
 	int32 getHeight() const { return _height; }
+
+	/** Decoded images, kept around so surfaces which get reloaded don't need decoding again. */
+	Image::ImageCache &getImageCache() { return _imageCache; }
 protected:
 	int32 _height;
 	int32 _width;
@@ -231,6 +236,7 @@ protected:
 	Rect32 _monitorRect;
 private:
 	Common::Array<BaseActiveRect *> _rectList;
+	Image::ImageCache _imageCache;
 	bool displaySaveloadImage();
 	bool displaySaveloadLines();
 };
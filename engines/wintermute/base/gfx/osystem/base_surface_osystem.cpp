@@ -68,7 +68,9 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	delete[] _alphaMask;
 	_alphaMask = nullptr;
 
-	_gameRef->addMem(-_width * _height * 4);
+	if (_valid) {
+		_gameRef->addMem(-_width * _height * 4);
+	}
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 }
@@ -103,7 +105,36 @@ bool BaseSurfaceOSystem::create(const Common::String &filename, bool defaultCK,
 }
 
 bool BaseSurfaceOSystem::finishLoad() {
+	// Savegame thumbnails change all the time, so they are never cached.
+	// The color key is applied after decoding, thus it's part of the key.
+	Image::ImageCache &imageCache = _gameRef->_renderer->getImageCache();
+	const bool useCache = !_filename.hasPrefix("savegame:");
+	const Common::Path cachePath(_filename);
+	const uint32 cacheVariant = (_ckRed << 16) | (_ckGreen << 8) | _ckBlue;
+
+	if (useCache) {
+		Graphics::AlphaType alphaType;
+		Image::ImageCache::SurfacePtr cached = imageCache.get(cachePath, g_system->getScreenFormat(), cacheVariant, &alphaType);
+		if (cached) {
+			// Share the cached pixels instead of copying them
+			_surface->free();
+			_sharedSurface = cached;
+
+			_width = cached->w;
+			_height = cached->h;
+			_alphaType = alphaType;
+			_valid = true;
+
+			_gameRef->addMem(_width * _height * 4);
+
+			_loaded = true;
+
+			return true;
+		}
+	}
+
 	BaseImage *image = new BaseImage();
+	image->setOutputPixelFormat(g_system->getScreenFormat());
 	if (!image->loadFile(_filename)) {
 		delete image;
 		return false;
@@ -118,6 +149,7 @@ bool BaseSurfaceOSystem::finishLoad() {
 		// FIBITMAP *newImg = FreeImage_ConvertToGreyscale(img); TODO
 	}
 
+	_sharedSurface.reset();
 	_surface->free();
 	delete _surface;
 
@@ -131,8 +163,12 @@ bool BaseSurfaceOSystem::finishLoad() {
 	} else if (image->getSurface()->format != g_system->getScreenFormat()) {
 		_surface = image->getSurface()->convertTo(g_system->getScreenFormat());
 	} else {
-		_surface = new Graphics::Surface();
-		_surface->copyFrom(*image->getSurface());
+		// Already in the screen format, so take over the decoded pixels
+		_surface = image->releaseSurface();
+		if (!_surface) {
+			_surface = new Graphics::Surface();
+			_surface->copyFrom(*image->getSurface());
+		}
 	}
 
 	if (BaseEngine::instance().getTargetExecutable() < WME_LITE) {
@@ -146,7 +182,7 @@ bool BaseSurfaceOSystem::finishLoad() {
 		// generic WME Lite ignores alpha channel for BMPs
 		needsColorKey = true;
 		replaceAlpha = false;
-	} else if (image->getSurface()->format.aBits() == 0) {
+	} else if (!image->hasAlpha()) {
 		// generic WME Lite does not use colorkey for non-BMPs with transparency
 		needsColorKey = true;
 	}
@@ -181,6 +217,12 @@ bool BaseSurfaceOSystem::finishLoad() {
 		}
 	}
 
+	if (useCache) {
+		// Hand the finished image over to the cache and share it from there
+		_sharedSurface = imageCache.insert(cachePath, _surface, cacheVariant, _alphaType);
+		_surface = new Graphics::Surface();
+	}
+
 	_loaded = true;
 
 	return true;
@@ -234,10 +276,10 @@ void BaseSurfaceOSystem::genAlphaMask(Graphics::Surface *surface) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-uint32 BaseSurfaceOSystem::getPixelAt(Graphics::Surface *surface, int x, int y) {
+uint32 BaseSurfaceOSystem::getPixelAt(const Graphics::Surface *surface, int x, int y) {
 	int bpp = surface->format.bytesPerPixel;
 	/* Here p is the address to the pixel we want to retrieve */
-	uint8 *p = (uint8 *)surface->getBasePtr(x, y);
+	const uint8 *p = (const uint8 *)surface->getBasePtr(x, y);
 
 	switch (bpp) {
 	case 1:
@@ -245,7 +287,7 @@ uint32 BaseSurfaceOSystem::getPixelAt(Graphics::Surface *surface, int x, int y)
 		break;
 
 	case 2:
-		return *(uint16 *)p;
+		return *(const uint16 *)p;
 		break;
 
 	case 3:
@@ -259,7 +301,7 @@ uint32 BaseSurfaceOSystem::getPixelAt(Graphics::Surface *surface, int x, int y)
 		break;
 
 	case 4:
-		return *(uint32 *)p;
+		return *(const uint32 *)p;
 		break;
 
 	default:
@@ -280,6 +322,33 @@ bool BaseSurfaceOSystem::create(int width, int height) {
 	return STATUS_OK;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::invalidate() {
+	// Only images loaded from a file can be decoded again on their next use
+	if (_filename.empty()) {
+		return STATUS_FAILED;
+	}
+	if (!_loaded) {
+		return STATUS_OK;
+	}
+
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
+	_sharedSurface.reset();
+	_surface->free();
+	delete[] _alphaMask;
+	_alphaMask = nullptr;
+
+	if (_valid) {
+		_gameRef->addMem(-_width * _height * 4);
+	}
+	_valid = false;
+	_loaded = false;
+
+	return STATUS_OK;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::isTransparentAt(int x, int y) {
 	return isTransparentAtLite(x, y);
@@ -287,14 +356,20 @@ bool BaseSurfaceOSystem::isTransparentAt(int x, int y) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::isTransparentAtLite(int x, int y) {
-	if (x < 0 || x >= _surface->w || y < 0 || y >= _surface->h) {
+	// The image may have been unloaded by invalidate()
+	if (!_loaded && !_filename.empty()) {
+		finishLoad();
+	}
+
+	const Graphics::Surface *surface = getSurface();
+	if (x < 0 || x >= surface->w || y < 0 || y >= surface->h) {
 		return true;
 	}
 
-	if (_surface->format.bytesPerPixel == 4) {
-		uint32 pixel = *(uint32 *)_surface->getBasePtr(x, y);
+	if (surface->format.bytesPerPixel == 4) {
+		uint32 pixel = *(const uint32 *)surface->getBasePtr(x, y);
 		uint8 r, g, b, a;
-		_surface->format.colorToARGB(pixel, a, r, g, b);
+		surface->format.colorToARGB(pixel, a, r, g, b);
 		if (a <= 128) {
 			return true;
 		} else {
@@ -417,12 +492,15 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 		transform._alphaDisable = true;
 	}
 
-	renderer->drawSurface(this, _surface, &srcRect, &position, transform);
+	renderer->drawSurface(this, getSurface(), &srcRect, &position, transform);
 	return STATUS_OK;
 }
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
 	_loaded = true;
+	// Cached images must not be modified, so stop sharing. The new pixels
+	// replace the whole image, thus there's nothing to copy over.
+	_sharedSurface.reset();
 	if (surface.format == _surface->format && surface.pitch == _surface->pitch && surface.h == _surface->h) {
 		const byte *src = (const byte *)surface.getBasePtr(0, 0);
 		byte *dst = (byte *)_surface->getBasePtr(0, 0);
@@ -33,6 +33,8 @@
 
 #include "engines/wintermute/base/gfx/base_surface.h"
 
+#include "image/image_cache.h"
+
 #include "common/list.h"
 
 namespace Wintermute {
@@ -44,6 +46,7 @@ public:
 
 	bool create(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime = -1, bool keepLoaded = false) override;
 	bool create(int width, int height) override;
+	bool invalidate() override;
 
 	bool isTransparentAt(int x, int y) override;
 	bool isTransparentAtLite(int x, int y) override;
@@ -64,8 +67,8 @@ public:
 		if (!_loaded) {
 			finishLoad();
 		}
-		if (_surface) {
-			return _surface->w;
+		if (getSurface()) {
+			return getSurface()->w;
 		}
 		return _width;
 	}
@@ -73,8 +76,8 @@ public:
 		if (!_loaded) {
 			finishLoad();
 		}
-		if (_surface) {
-			return _surface->h;
+		if (getSurface()) {
+			return getSurface()->h;
 		}
 		return _height;
 	}
@@ -82,9 +85,9 @@ public:
 		if (!_loaded) {
 			finishLoad();
 		}
-		if (_surface) {
-			uint32 pixel = getPixelAt(_surface, x, y);
-			_surface->format.colorToARGB(pixel, *a, *r, *g, *b);
+		if (getSurface()) {
+			uint32 pixel = getPixelAt(getSurface(), x, y);
+			getSurface()->format.colorToARGB(pixel, *a, *r, *g, *b);
 			return STATUS_OK;
 		}
 		return STATUS_FAILED;
@@ -93,11 +96,16 @@ public:
 	Graphics::AlphaType getAlphaType() const { return _alphaType; }
 private:
 	Graphics::Surface *_surface;
+	/** The image shared with the renderer's image cache, which takes the place of _surface. */
+	Image::ImageCache::SurfacePtr _sharedSurface;
+	const Graphics::Surface *getSurface() const {
+		return _sharedSurface ? _sharedSurface.get() : _surface;
+	}
 	bool _loaded;
 	bool finishLoad();
 	bool drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect, Graphics::TransformStruct transformStruct);
 	void genAlphaMask(Graphics::Surface *surface);
-	uint32 getPixelAt(Graphics::Surface *surface, int x, int y);
+	uint32 getPixelAt(const Graphics::Surface *surface, int x, int y);
 
 	uint32 _rotation;
 	Graphics::AlphaType _alphaType;
@@ -22,6 +22,8 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/gfx/base_renderer.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -34,6 +36,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("image_cache", WRAP_METHOD(Console, Cmd_ImageCache));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -291,6 +294,27 @@ bool Console::Cmd_Set(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_ImageCache(int argc, const char **argv) {
+	if (!_engineRef->_game || !_engineRef->_game->_renderer) {
+		debugPrintf("No game is running\n");
+		return true;
+	}
+
+	Image::ImageCache &cache = _engineRef->_game->_renderer->getImageCache();
+
+	if (argc == 2 && Common::String(argv[1]) == "clear") {
+		cache.clear();
+		cache.resetStats();
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [clear]\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("%u images, %u of %u KB used\n", cache.getCount(), cache.getUsedBytes() / 1024, cache.getMaxBytes() / 1024);
+	debugPrintf("%u hits, %u misses, %u evictions\n", cache.getHits(), cache.getMisses(), cache.getEvictions());
+	return true;
+}
+
 bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	if (argc == 2) {
 		if (Common::String(argv[1]) == "true") {
@@ -45,15 +45,12 @@ MJPEGDecoder::MJPEGDecoder() : Codec() {
 	if (_pixelFormat.bytesPerPixel == 1)
 		_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 
-	_surface = 0;
 	_accuracy = CodecAccuracy::Default;
+	_jpeg = new JPEGDecoder();
 }
 
 MJPEGDecoder::~MJPEGDecoder() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
+	delete _jpeg;
 }
 
 // Header to be inserted
@@ -167,13 +164,13 @@ const Graphics::Surface *MJPEGDecoder::decodeFrame(Common::SeekableReadStream &s
 		return 0;
 	}
 
+	// The buffer only ever grows, so that consecutive frames don't need
+	// to allocate any memory
 	uint32 outputSize = stream.size() - inputSkip + sizeof(s_jpegHeader) + DHT_SEGMENT_SIZE;
-	byte *data = (byte *)malloc(outputSize);
+	if (_jpegData.size() < outputSize)
+		_jpegData.resize(outputSize);
 
-	if (!data) {
-		warning("Failed to allocate data for MJPEG conversion");
-		return 0;
-	}
+	byte *data = _jpegData.data();
 
 	// Copy the header
 	memcpy(data, s_jpegHeader, sizeof(s_jpegHeader));
@@ -203,27 +200,21 @@ const Graphics::Surface *MJPEGDecoder::decodeFrame(Common::SeekableReadStream &s
 	stream.seek(inputSkip);
 	stream.read(data + dataOffset, stream.size() - inputSkip);
 
-	Common::MemoryReadStream convertedStream(data, outputSize, DisposeAfterUse::YES);
-	JPEGDecoder jpeg;
-	jpeg.setCodecAccuracy(_accuracy);
-	jpeg.setOutputPixelFormat(_pixelFormat);
+	Common::MemoryReadStream convertedStream(data, outputSize);
+	_jpeg->setCodecAccuracy(_accuracy);
+	_jpeg->setOutputPixelFormat(_pixelFormat);
 
-	if (!jpeg.loadStream(convertedStream)) {
+	if (!_jpeg->loadStream(convertedStream)) {
 		warning("Failed to decode MJPEG frame");
 		return 0;
 	}
 
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
-
-	_surface = new Graphics::Surface();
-	_surface->copyFrom(*jpeg.getSurface());
-
-	assert(_surface->format == _pixelFormat);
+	// The decoded surface stays owned by the JPEG decoder and is valid until
+	// the next frame is decoded, so there is no need to copy it.
+	const Graphics::Surface *surface = _jpeg->getSurface();
+	assert(surface->format == _pixelFormat);
 
-	return _surface;
+	return surface;
 }
 
 void MJPEGDecoder::setCodecAccuracy(CodecAccuracy accuracy) {
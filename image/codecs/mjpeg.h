@@ -22,6 +22,7 @@
 #ifndef IMAGE_CODECS_MJPEG_H
 #define IMAGE_CODECS_MJPEG_H
 
+#include "common/array.h"
 #include "image/codecs/codec.h"
 #include "graphics/pixelformat.h"
 
@@ -35,6 +36,8 @@ struct Surface;
 
 namespace Image {
 
+class JPEGDecoder;
+
 /**
  * Motion JPEG decoder.
  *
@@ -52,8 +55,12 @@ public:
 
 private:
 	Graphics::PixelFormat _pixelFormat;
-	Graphics::Surface *_surface;
 	CodecAccuracy _accuracy;
+
+	/** The JPEG decoder, kept between frames so its surface is reused. */
+	JPEGDecoder *_jpeg;
+	/** Buffer for the reconstructed JPEG stream, kept between frames. */
+	Common::Array<byte> _jpegData;
 };
 
 } // End of namespace Image
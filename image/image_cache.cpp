@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "image/image_cache.h"
+
+namespace Image {
+
+uint ImageCache::Key_Hash::operator()(const Key &x) const {
+	const Graphics::PixelFormat &f = x.format;
+	uint formatHash = f.bytesPerPixel
+		| (f.rLoss << 4) | (f.gLoss << 8) | (f.bLoss << 12) | (f.aLoss << 16)
+		| (f.rShift << 20) | (f.gShift << 24) | (f.bShift << 28);
+
+	return Common::Path::IgnoreCase_Hash()(x.path) ^ formatHash ^ (f.aShift * 31) ^ (x.variant * 2654435761U);
+}
+
+bool ImageCache::Key_EqualTo::operator()(const Key &x, const Key &y) const {
+	return x.variant == y.variant && x.format == y.format && x.path.equalsIgnoreCase(y.path);
+}
+
+ImageCache::ImageCache(uint32 maxBytes) :
+		_maxBytes(maxBytes), _usedBytes(0), _hits(0), _misses(0), _evictions(0) {
+}
+
+ImageCache::~ImageCache() {
+	clear();
+}
+
+ImageCache::SurfacePtr ImageCache::get(const Common::Path &path, const Graphics::PixelFormat &format, uint32 variant, Graphics::AlphaType *alphaType) {
+	EntryMap::iterator it = _map.find(Key(path, format, variant));
+	if (it == _map.end()) {
+		_misses++;
+		return SurfacePtr();
+	}
+
+	_hits++;
+
+	// Move the entry to the front of the LRU list
+	EntryList::iterator entry = it->_value;
+	if (entry != _entries.begin()) {
+		_entries.push_front(*entry);
+		_entries.erase(entry);
+		it->_value = _entries.begin();
+	}
+
+	if (alphaType)
+		*alphaType = _entries.front().alphaType;
+
+	return _entries.front().surface;
+}
+
+ImageCache::SurfacePtr ImageCache::insert(const Common::Path &path, Graphics::Surface *surface, uint32 variant, Graphics::AlphaType alphaType) {
+	assert(surface);
+
+	const Key key(path, surface->format, variant);
+
+	EntryMap::iterator it = _map.find(key);
+	if (it != _map.end())
+		remove(it->_value);
+
+	SurfacePtr ptr(surface, Graphics::SurfaceDeleter());
+	uint32 size = surface->h * surface->pitch;
+
+	_entries.push_front(Entry(key, ptr, size, alphaType));
+	_map[key] = _entries.begin();
+	_usedBytes += size;
+
+	evict();
+
+	return ptr;
+}
+
+void ImageCache::clear() {
+	_entries.clear();
+	_map.clear();
+	_usedBytes = 0;
+}
+
+void ImageCache::setMaxBytes(uint32 maxBytes) {
+	_maxBytes = maxBytes;
+	evict();
+}
+
+void ImageCache::remove(EntryList::iterator entry) {
+	_usedBytes -= entry->size;
+	_map.erase(entry->key);
+	_entries.erase(entry);
+}
+
+void ImageCache::evict() {
+	if (_usedBytes <= _maxBytes)
+		return;
+
+	// Walk from the least recently used entry, skipping the images which
+	// are still in use elsewhere.
+	EntryList::iterator entry = _entries.end();
+	while (_usedBytes > _maxBytes && entry != _entries.begin()) {
+		--entry;
+
+		if (entry->surface.refCount() > 1)
+			continue;
+
+		EntryList::iterator victim = entry++;
+		remove(victim);
+		_evictions++;
+	}
+}
+
+} // End of namespace Image
@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IMAGE_IMAGECACHE_H
+#define IMAGE_IMAGECACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/noncopyable.h"
+#include "common/path.h"
+#include "common/ptr.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+namespace Image {
+
+/**
+ * @defgroup image_cache Decoded image cache
+ * @ingroup image
+ *
+ * @brief Cache for decoded and converted images.
+ * @{
+ */
+
+/**
+ * A byte-budgeted cache of decoded images.
+ *
+ * Images are identified by the archive path they were loaded from, the pixel
+ * format they were converted to, and an optional variant chosen by the caller
+ * (e.g. the color key which was applied after decoding). Cached surfaces are
+ * handed out as reference-counted handles and must not be modified, so users
+ * can share them instead of keeping copies. The alpha type of each image is
+ * stored along with it, so it doesn't have to be detected again.
+ *
+ * When the total size of the cached surfaces exceeds the budget, the least
+ * recently used images are evicted. Images which are still referenced outside
+ * of the cache are never evicted, but their memory only counts as long as they
+ * are part of the cache.
+ */
+class ImageCache : Common::NonCopyable {
+public:
+	typedef Common::SharedPtr<const Graphics::Surface> SurfacePtr;
+
+	/**
+	 * Create a new cache.
+	 *
+	 * @param maxBytes The budget for the pixel data of all cached images.
+	 */
+	explicit ImageCache(uint32 maxBytes);
+	~ImageCache();
+
+	/**
+	 * Look up a cached image and mark it as most recently used.
+	 *
+	 * @param alphaType If not null, receives the alpha type stored with the image.
+	 * @return The cached surface, or an empty handle if it is not cached.
+	 */
+	SurfacePtr get(const Common::Path &path, const Graphics::PixelFormat &format, uint32 variant = 0, Graphics::AlphaType *alphaType = nullptr);
+
+	/**
+	 * Add an image to the cache, replacing any image with the same key.
+	 *
+	 * The cache takes ownership of the surface, which is freed once it is
+	 * evicted and no longer referenced. The surface's format is used as
+	 * part of the key.
+	 *
+	 * @param alphaType The alpha type of the surface, as returned by
+	 *                  Graphics::Surface::detectAlpha().
+	 * @return A handle to the cached surface.
+	 */
+	SurfacePtr insert(const Common::Path &path, Graphics::Surface *surface, uint32 variant = 0, Graphics::AlphaType alphaType = Graphics::ALPHA_FULL);
+
+	/** Remove all images from the cache. */
+	void clear();
+
+	/** Change the budget, evicting images if necessary. */
+	void setMaxBytes(uint32 maxBytes);
+	uint32 getMaxBytes() const { return _maxBytes; }
+
+	/** Return the size of the pixel data of all cached images. */
+	uint32 getUsedBytes() const { return _usedBytes; }
+	/** Return the number of cached images. */
+	uint getCount() const { return _entries.size(); }
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getEvictions() const { return _evictions; }
+	void resetStats() { _hits = _misses = _evictions = 0; }
+
+private:
+	struct Key {
+		Common::Path path;
+		Graphics::PixelFormat format;
+		uint32 variant;
+
+		Key(const Common::Path &p, const Graphics::PixelFormat &f, uint32 v) : path(p), format(f), variant(v) {}
+	};
+
+	struct Key_Hash {
+		uint operator()(const Key &x) const;
+	};
+
+	struct Key_EqualTo {
+		bool operator()(const Key &x, const Key &y) const;
+	};
+
+	struct Entry {
+		Key key;
+		SurfacePtr surface;
+		uint32 size;
+		Graphics::AlphaType alphaType;
+
+		Entry(const Key &k, const SurfacePtr &s, uint32 sz, Graphics::AlphaType a) : key(k), surface(s), size(sz), alphaType(a) {}
+	};
+
+	/** All entries, the most recently used one first. */
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, Key_Hash, Key_EqualTo> EntryMap;
+
+	EntryList _entries;
+	EntryMap _map;
+
+	uint32 _maxBytes;
+	uint32 _usedBytes;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+
+	void remove(EntryList::iterator entry);
+	void evict();
+};
+
+/** @} */
+
+} // End of namespace Image
+
+#endif
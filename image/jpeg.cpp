@@ -30,6 +30,7 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -71,6 +72,13 @@ void JPEGDecoder::destroy() {
 	_surface.free();
 }
 
+void JPEGDecoder::allocateSurface(uint16 width, uint16 height, const Graphics::PixelFormat &format) {
+	if (_surface.getPixels() && _surface.w == width && _surface.h == height && _surface.format == format)
+		return;
+
+	_surface.create(width, height, format);
+}
+
 const Graphics::Surface *JPEGDecoder::decodeFrame(Common::SeekableReadStream &stream) {
 	if (!loadStream(stream))
 		return 0;
@@ -234,8 +242,11 @@ J_COLOR_SPACE fromScummvmPixelFormat(const Graphics::PixelFormat &format) {
 
 bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #ifdef USE_JPEG
-	// Reset member variables from previous decodings
-	destroy();
+	// The surface of the previous decoding is only freed when the new image
+	// needs a different size or format. This way decoding a sequence of
+	// images, like the frames of a video, doesn't allocate memory each time.
+	// A failed load still frees it, so getSurface() never returns an image
+	// left over from an earlier call.
 
 	jpeg_decompress_struct cinfo;
 	jpeg_error_mgr jerr;
@@ -293,52 +304,72 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	jpeg_start_decompress(&cinfo);
 
 	// Allocate buffers for the output data
+	// The format libjpeg writes its scanlines in
+	Graphics::PixelFormat decodePixelFormat;
 	switch (_colorSpace) {
 	case kColorSpaceRGB: {
-		Graphics::PixelFormat outputPixelFormat;
 		if (cinfo.out_color_space == JCS_RGB) {
-			outputPixelFormat = getByteOrderRgbPixelFormat();
+			decodePixelFormat = getByteOrderRgbPixelFormat();
+		} else {
+			decodePixelFormat = _requestedPixelFormat;
+		}
+
+		// When libjpeg cannot output the requested format directly, we
+		// convert each scanline as soon as it is decoded. This saves an
+		// additional pass over the whole image.
+		if (_requestedPixelFormat.bytesPerPixel >= 2) {
+			allocateSurface(cinfo.output_width, cinfo.output_height, _requestedPixelFormat);
 		} else {
-			outputPixelFormat = _requestedPixelFormat;
+			allocateSurface(cinfo.output_width, cinfo.output_height, decodePixelFormat);
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
 		break;
 	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		decodePixelFormat = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
+		allocateSurface(cinfo.output_width, cinfo.output_height, decodePixelFormat);
 		break;
 	default:
-		break;
+		// Don't leave the previous image around for callers to pick up
+		destroy();
+		jpeg_destroy_decompress(&cinfo);
+		return false;
 	}
 	// Size of output pixel must match 4 bytes.
 	if (cinfo.out_color_space == JCS_CMYK) {
 		assert(_surface.format.bytesPerPixel == 4);
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	if (_surface.format == decodePixelFormat) {
+		// Let libjpeg write the scanlines directly into the surface
+		assert(_surface.pitch >= (int)(cinfo.output_width * _surface.format.bytesPerPixel));
+
+		while (cinfo.output_scanline < cinfo.output_height) {
+			JSAMPROW dst = (JSAMPROW)_surface.getBasePtr(0, cinfo.output_scanline);
+
+			jpeg_read_scanlines(&cinfo, &dst, 1);
+		}
+	} else {
+		// Allocate buffer for one scanline
+		JDIMENSION pitch = cinfo.output_width * decodePixelFormat.bytesPerPixel;
+		JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
 
-	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+		// Go through the image data scanline by scanline
+		while (cinfo.output_scanline < cinfo.output_height) {
+			byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+			jpeg_read_scanlines(&cinfo, buffer, 1);
 
-		memcpy(dst, buffer[0], pitch);
+			Graphics::crossBlit(dst, buffer[0], _surface.pitch, pitch, cinfo.output_width, 1,
+				_surface.format, decodePixelFormat);
+		}
 	}
 
 	// We are done with decompressing, thus free all the data
 	jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
-		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
-	}
-
 	return true;
 #else
 	return false;
@@ -104,6 +104,8 @@ private:
 	CodecAccuracy _accuracy;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
+	/** (Re)allocate the output surface, unless it already has the given size and format. */
+	void allocateSurface(uint16 width, uint16 height, const Graphics::PixelFormat &format);
 };
 /** @} */
 } // End of namespace Image
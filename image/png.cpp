@@ -30,6 +30,7 @@
 
 #include "image/png.h"
 
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -46,7 +47,9 @@ PNGDecoder::PNGDecoder() :
 		_skipSignature(false),
 		_keepTransparencyPaletted(false),
 		_hasTransparentColor(false),
-		_transparentColor(0) {
+		_transparentColor(0),
+		_hasAlpha(false),
+		_outputPixelFormat() {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -62,6 +65,13 @@ void PNGDecoder::destroy() {
 	delete[] _palette;
 	_palette = NULL;
 	_hasTransparentColor = false;
+	_hasAlpha = false;
+}
+
+Graphics::Surface *PNGDecoder::releaseSurface() {
+	Graphics::Surface *surface = _outputSurface;
+	_outputSurface = nullptr;
+	return surface;
 }
 
 Graphics::PixelFormat PNGDecoder::getByteOrderRgbaPixelFormat(bool isAlpha) const {
@@ -156,6 +166,12 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	uint32 rgbaPalette[256];
 	bool hasRgbaPalette = false;
 
+	// The byte order RGBA format libpng writes true color rows in
+	Graphics::PixelFormat rgbaFormat;
+	// Whether decoded rows must be converted to the requested output format
+	bool convertRows = false;
+	bool wantOutputFormat = (_outputPixelFormat.bytesPerPixel == 2 || _outputPixelFormat.bytesPerPixel == 4);
+
 	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, &interlaceType, NULL, NULL);
 	width = w;
 	height = h;
@@ -199,11 +215,14 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 				// _transparentColor, and will instead need to build an RGBA surface
 				assert(numTrans > 1);
 				hasRgbaPalette = true;
+				_hasAlpha = true;
 			}
 		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
+		if (!hasRgbaPalette)
+			_outputSurface->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+		else
+			_outputSurface->create(width, height, wantOutputFormat ? _outputPixelFormat : getByteOrderRgbaPixelFormat(true));
 		png_set_packing(pngPtr);
 
 		if (hasRgbaPalette) {
@@ -227,7 +246,11 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
+		_hasAlpha = isAlpha;
+		rgbaFormat = getByteOrderRgbaPixelFormat(isAlpha);
+		convertRows = wantOutputFormat && _outputPixelFormat != rgbaFormat;
+
+		_outputSurface->create(width, height, convertRows ? _outputPixelFormat : rgbaFormat);
 		if (!_outputSurface->getPixels()) {
 			error("Could not allocate memory for output image.");
 		}
@@ -258,14 +281,37 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		for (int yp = 0; yp < height; ++yp) {
 			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
 
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			if (_outputSurface->format.bytesPerPixel == 2) {
+				uint16 *destRowP = (uint16 *)_outputSurface->getBasePtr(0, yp);
+
+				for (int xp = 0; xp < width; ++xp)
+					destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			} else {
+				uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
+
+				for (int xp = 0; xp < width; ++xp)
+					destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			}
 		}
 
 		delete[] rowPtr;
-	} else  if (interlaceType == PNG_INTERLACE_NONE) {
+	} else if (interlaceType == PNG_INTERLACE_NONE && convertRows) {
+		// Decode each row into a scratch buffer and convert it straight
+		// into the requested output format.
+		png_bytep rowPtr = new byte[width * rgbaFormat.bytesPerPixel];
+		if (!rowPtr)
+			error("Could not allocate memory for row.");
+
+		for (int i = 0; i < height; i++) {
+			png_read_row(pngPtr, rowPtr, nullptr);
+			Graphics::crossBlit((byte *)_outputSurface->getBasePtr(0, i), rowPtr,
+				_outputSurface->pitch, width * rgbaFormat.bytesPerPixel, width, 1,
+				_outputSurface->format, rgbaFormat);
+		}
+
+		delete[] rowPtr;
+	} else if (interlaceType == PNG_INTERLACE_NONE) {
 		// PNGs without interlacing can simply be read row by row.
 		for (int i = 0; i < height; i++) {
 			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
@@ -273,6 +319,14 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	} else {
 		// PNGs with interlacing require us to allocate an auxiliary
 		// buffer with pointers to all row starts.
+		// As every pass touches every row, rows which need converting can
+		// only be converted once the whole image has been decoded.
+		Graphics::Surface interlacedSurface;
+		Graphics::Surface *decodeSurface = _outputSurface;
+		if (convertRows) {
+			interlacedSurface.create(width, height, rgbaFormat);
+			decodeSurface = &interlacedSurface;
+		}
 
 		// Allocate row pointer buffer
 		png_bytep *rowPtr = new png_bytep[height];
@@ -282,13 +336,20 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		// Initialize row pointers
 		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+			rowPtr[i] = (png_bytep)decodeSurface->getBasePtr(0, i);
 
 		// Read image data
 		png_read_image(pngPtr, rowPtr);
 
 		// Free row pointer buffer
 		delete[] rowPtr;
+
+		if (convertRows) {
+			Graphics::crossBlit((byte *)_outputSurface->getPixels(), (const byte *)interlacedSurface.getPixels(),
+				_outputSurface->pitch, interlacedSurface.pitch, width, height,
+				_outputSurface->format, rgbaFormat);
+			interlacedSurface.free();
+		}
 	}
 
 	// Read additional data at the end.
@@ -67,6 +67,32 @@ public:
 	uint32 getTransparentColor() const override { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the pixel format used for true color images.
+	 *
+	 * Each row is converted as soon as it is decoded, so no second pass over
+	 * the whole image is needed. Paletted images without an alpha palette are
+	 * not affected and are still returned as CLUT8.
+	 *
+	 * @param format The pixel format to output, which must have 2 or 4 bytes
+	 *               per pixel.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputPixelFormat = format; }
+
+	/**
+	 * Return whether the decoded image has an alpha channel.
+	 *
+	 * Unlike the format of the output surface, this does not depend on the
+	 * format requested with setOutputPixelFormat().
+	 */
+	bool hasAlpha() const { return _hasAlpha; }
+
+	/**
+	 * Hand the decoded surface over to the caller, who becomes responsible
+	 * for freeing and deleting it. getSurface() returns nullptr afterwards.
+	 */
+	Graphics::Surface *releaseSurface();
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
 
@@ -80,7 +106,9 @@ private:
 	bool _keepTransparencyPaletted;
 	bool _hasTransparentColor;
 	uint32 _transparentColor;
+	bool _hasAlpha;
 
+	Graphics::PixelFormat _outputPixelFormat;
 	Graphics::Surface *_outputSurface;
 };
 
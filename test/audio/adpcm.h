@@ -0,0 +1,144 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/adpcm.h"
+#include "audio/audiostream.h"
+
+#include "common/memstream.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class ADPCMTestSuite : public CxxTest::TestSuite {
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+
+	/**
+	 * Create pseudo-random ADPCM data with valid block headers. The last
+	 * block is cut short after lastBlockSize bytes.
+	 */
+	static byte *createData(Audio::ADPCMType type, int channels, uint32 blockAlign, uint32 blocks, uint32 lastBlockSize, uint32 &size) {
+		size = blocks * blockAlign + lastBlockSize;
+		byte *data = (byte *)malloc(size);
+
+		uint32 seed = 1234 + type * 17 + channels;
+		for (uint32 i = 0; i < size; i++)
+			data[i] = nextRandom(seed) & 0xff;
+
+		for (uint32 block = 0; block <= blocks && blockAlign; block++) {
+			byte *header = data + block * blockAlign;
+			if (block == blocks && !lastBlockSize)
+				break;
+
+			if (type == Audio::kADPCMMSIma) {
+				for (int i = 0; i < channels; i++) {
+					WRITE_LE_UINT16(header + i * 4 + 2, nextRandom(seed) % 89);
+				}
+			} else if (type == Audio::kADPCMMS) {
+				for (int i = 0; i < channels; i++) {
+					header[i] = nextRandom(seed) % 7;
+					WRITE_LE_UINT16(header + channels + i * 2, 16 + nextRandom(seed) % 2000);
+				}
+			}
+		}
+
+		return data;
+	}
+
+	static Audio::SeekableAudioStream *createStream(Audio::ADPCMType type, int channels, uint32 blockAlign, uint32 blocks, uint32 lastBlockSize) {
+		uint32 size;
+		byte *data = createData(type, channels, blockAlign, blocks, lastBlockSize, size);
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+		return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+	}
+
+	/**
+	 * Decode the whole stream, requesting the given numbers of samples in
+	 * turn, and return a checksum of the output.
+	 */
+	static uint32 decode(Audio::AudioStream *stream, const int *chunks, int numChunks, uint32 &total) {
+		int16 buffer[4096];
+		uint32 checksum = 0;
+		total = 0;
+
+		for (int chunk = 0; ; chunk = (chunk + 1) % numChunks) {
+			const int read = stream->readBuffer(buffer, chunks[chunk]);
+			if (read <= 0)
+				break;
+			for (int i = 0; i < read; i++)
+				checksum = checksum * 31 + (uint16)buffer[i];
+			total += read;
+		}
+
+		TS_ASSERT(stream->endOfData());
+		return checksum;
+	}
+
+	static void check(Audio::ADPCMType type, int channels, uint32 blockAlign, uint32 blocks, uint32 lastBlockSize, uint32 expectedChecksum, uint32 expectedTotal) {
+		// Decode everything in one go, then in odd chunk sizes
+		const int whole[] = { 4096 };
+		const int odd[] = { 2, 6, 30, 1002, 14, 2048 };
+
+		Audio::SeekableAudioStream *stream = createStream(type, channels, blockAlign, blocks, lastBlockSize);
+		uint32 total;
+		TS_ASSERT_EQUALS(decode(stream, whole, ARRAYSIZE(whole), total), expectedChecksum);
+		TS_ASSERT_EQUALS(total, expectedTotal);
+
+		TS_ASSERT(stream->rewind());
+		TS_ASSERT_EQUALS(decode(stream, odd, ARRAYSIZE(odd), total), expectedChecksum);
+		TS_ASSERT_EQUALS(total, expectedTotal);
+		delete stream;
+	}
+
+public:
+	// The checksums were taken from the nibble by nibble decoders, which
+	// the block decoders must match exactly
+	void test_oki() {
+		check(Audio::kADPCMOki, 1, 0, 0, 5001, 3777314528U, 10002);
+	}
+
+	void test_dvi() {
+		check(Audio::kADPCMDVI, 1, 0, 0, 5001, 2071656328U, 10002);
+		check(Audio::kADPCMDVI, 2, 0, 0, 5001, 1295021898U, 10002);
+	}
+
+	void test_ms_ima() {
+		check(Audio::kADPCMMSIma, 1, 256, 7, 4 + 4 * 13, 3182276345U, 3632);
+		check(Audio::kADPCMMSIma, 2, 512, 6, 8 + 8 * 10, 3452386947U, 6208);
+	}
+
+	void test_ms() {
+		check(Audio::kADPCMMS, 1, 256, 7, 7 + 33, 217025922U, 3568);
+		check(Audio::kADPCMMS, 2, 512, 6, 14 + 41, 3601212969U, 6086);
+	}
+
+	void test_decode_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const Audio::ADPCMType types[] = { Audio::kADPCMOki, Audio::kADPCMDVI, Audio::kADPCMMSIma, Audio::kADPCMMS };
+		const char *names[] = { "Oki", "DVI", "MS IMA", "MS" };
+		const int chunks[] = { 1024 };
+
+		for (int i = 0; i < ARRAYSIZE(types); i++) {
+			Audio::SeekableAudioStream *stream = createStream(types[i], 2, 2048, 512, 0);
+
+			uint32 total;
+			const uint32 start = g_system->getMillis();
+			for (int pass = 0; pass < 4; pass++) {
+				stream->rewind();
+				decode(stream, chunks, ARRAYSIZE(chunks), total);
+			}
+			debug("%s ADPCM: decoded %u samples four times in %u ms", names[i], total, g_system->getMillis() - start);
+
+			delete stream;
+		}
+#endif
+	}
+};
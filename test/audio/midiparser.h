@@ -0,0 +1,165 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mididrv.h"
+#include "audio/midiparser.h"
+
+class MidiParserTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Records the events sent in each onTimer call, together with the time
+	 * offset they were sent with.
+	 */
+	class RecordingDriver : public MidiDriver_BASE {
+	public:
+		RecordingDriver() : _offset(-1), _numEvents(0), _numNoteOns(0), _numNoteOffs(0), _inOrder(true) {}
+
+		void send(uint32 b) override {
+			TS_ASSERT_LESS_THAN(_numEvents, (int)ARRAYSIZE(_events));
+			if (_numEvents >= (int)ARRAYSIZE(_events))
+				return;
+			_events[_numEvents].event = b;
+			_events[_numEvents].offset = _offset;
+			++_numEvents;
+
+			if ((b & 0xF0) == 0x90)
+				++_numNoteOns;
+			else if ((b & 0xF0) == 0x80)
+				++_numNoteOffs;
+		}
+
+		void setEventTimeOffset(int32 usecs) override {
+			// Within one onTimer call, the offsets may never go back
+			if (usecs >= 0 && _offset >= 0 && usecs < _offset)
+				_inOrder = false;
+			_offset = usecs;
+		}
+
+		/** Returns the offset a note off for the specified note was sent with, or -2 if none was sent. */
+		int32 noteOffOffset(byte note) const {
+			for (int i = 0; i < _numEvents; ++i) {
+				if ((_events[i].event & 0xF0) == 0x80 && ((_events[i].event >> 8) & 0x7F) == note)
+					return _events[i].offset;
+			}
+			return -2;
+		}
+
+		void clear() { _numEvents = 0; }
+
+		struct Event {
+			uint32 event;
+			int32 offset;
+		};
+
+		int32 _offset;
+		Event _events[64];
+		int _numEvents;
+		int _numNoteOns;
+		int _numNoteOffs;
+		bool _inOrder;
+	};
+
+	/**
+	 * Parses a track of 4 byte records in the style of XMIDI, where note ons
+	 * carry their duration instead of being followed by a note off:
+	 * delta ticks, event, note (or meta type), duration in ticks.
+	 */
+	class DurationParser : public MidiParser {
+	public:
+		bool loadMusic(byte *data, uint32 size) override {
+			_tracks[0] = data;
+			_numTracks = 1;
+			_ppqn = 96;
+			setTempo(96000); // 1 ms per tick
+			return setTrack(0);
+		}
+
+	protected:
+		void parseNextEvent(EventInfo &info) override {
+			byte *&pos = _position._playPos;
+			info.start = pos;
+			info.delta = pos[0];
+			info.event = pos[1];
+			if (info.event == 0xFF) {
+				info.ext.type = pos[2];
+				info.ext.data = pos + 4;
+				info.length = 0;
+			} else {
+				info.basic.param1 = pos[2];
+				info.basic.param2 = 0x7F;
+				info.length = (info.command() == 0x9) ? pos[3] : 0;
+			}
+			pos += 4;
+		}
+	};
+
+public:
+	void test_hanging_note_offs_in_time_order() {
+		// With 10 ms timer calls, note 60 ends 9 ms into the second call,
+		// after the events at 2, 7 and 8 ms in that call.
+		byte track[] = {
+			0, 0x90, 60, 19,
+			12, 0x91, 62, 30,
+			5, 0xB1, 0x07, 0,
+			1, 0x92, 64, 3,
+			30, 0xFF, 0x2F, 0
+		};
+
+		RecordingDriver driver;
+		DurationParser *parser = new DurationParser();
+		parser->setMidiDriver(&driver);
+		parser->setTimerRate(10000);
+		TS_ASSERT(parser->loadMusic(track, sizeof(track)));
+
+		for (int i = 0; i < 8; ++i) {
+			driver.clear();
+			driver._offset = -1;
+			parser->onTimer();
+
+			if (i == 1) {
+				TS_ASSERT_EQUALS(driver._numEvents, 4);
+				TS_ASSERT_EQUALS(driver.noteOffOffset(60), 9000);
+			}
+		}
+
+		TS_ASSERT(driver._inOrder);
+		TS_ASSERT_EQUALS(driver._numNoteOns, 3);
+		TS_ASSERT_EQUALS(driver._numNoteOffs, 3);
+
+		delete parser;
+	}
+
+	void test_hanging_note_recycled() {
+		// Note 60 is due 5 ms into the second call, but is played again at
+		// 3 ms. The old note is turned off at 3 ms and the new one is kept.
+		byte track[] = {
+			0, 0x90, 60, 15,
+			13, 0x90, 60, 20,
+			40, 0xFF, 0x2F, 0
+		};
+
+		RecordingDriver driver;
+		DurationParser *parser = new DurationParser();
+		parser->setMidiDriver(&driver);
+		parser->setTimerRate(10000);
+		TS_ASSERT(parser->loadMusic(track, sizeof(track)));
+
+		parser->onTimer();
+		driver.clear();
+		driver._offset = -1;
+		parser->onTimer();
+		TS_ASSERT_EQUALS(driver._numEvents, 2);
+		TS_ASSERT_EQUALS(driver._events[0].event & 0xFFFF, 0x3C80u);
+		TS_ASSERT_EQUALS(driver._events[0].offset, 3000);
+		TS_ASSERT_EQUALS(driver._events[1].event & 0xFFFF, 0x3C90u);
+
+		for (int i = 0; i < 6; ++i) {
+			driver._offset = -1;
+			parser->onTimer();
+		}
+
+		TS_ASSERT(driver._inOrder);
+		TS_ASSERT_EQUALS(driver._numNoteOns, 2);
+		TS_ASSERT_EQUALS(driver._numNoteOffs, 2);
+
+		delete parser;
+	}
+};
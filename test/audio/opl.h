@@ -0,0 +1,121 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/dbopl.h"
+#include "audio/softsynth/opl/nuked.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class OPLTestSuite : public CxxTest::TestSuite {
+	enum {
+		kRate = 44100
+	};
+
+	// Plays a chord on six channels, using all waveforms and both speakers
+	template<class Chip, void (*WriteReg)(Chip *, uint16, uint8)>
+	static void setupChord(Chip *chip) {
+		WriteReg(chip, 0x105, 1);
+		for (int ch = 0; ch < 6; ch++) {
+			const int op = (ch % 3) + (ch / 3) * 8;
+			for (int i = 0; i < 2; i++) {
+				WriteReg(chip, 0x20 + op + i * 3, 0x21 + ch);
+				WriteReg(chip, 0x40 + op + i * 3, i ? 0x00 : 0x10 + ch);
+				WriteReg(chip, 0x60 + op + i * 3, 0xF2 - ch);
+				WriteReg(chip, 0x80 + op + i * 3, 0x54);
+				WriteReg(chip, 0xE0 + op + i * 3, (ch + i) & 7);
+			}
+			WriteReg(chip, 0xC0 + ch, 0x30 | (ch << 1) | (ch & 1));
+			WriteReg(chip, 0xA0 + ch, 0x41 + ch * 0x20);
+			WriteReg(chip, 0xB0 + ch, 0x30 + ch);
+		}
+	}
+
+#ifndef DISABLE_NUKED_OPL
+	static void writeNuked(OPL::NUKED::opl3_chip *chip, uint16 reg, uint8 val) {
+		OPL::NUKED::OPL3_WriteReg(chip, reg, val);
+	}
+#endif
+
+#ifndef DISABLE_DOSBOX_OPL
+	static void writeDOSBox(OPL::DOSBox::DBOPL::Chip *chip, uint16 reg, uint8 val) {
+		chip->WriteReg(reg, val);
+	}
+#endif
+
+public:
+	// The stream renderer must match generating the output sample by sample
+	void test_nuked_stream() {
+#ifndef DISABLE_NUKED_OPL
+		const int numSamples = kRate / 2;
+		OPL::NUKED::opl3_chip *stream = new OPL::NUKED::opl3_chip();
+		OPL::NUKED::opl3_chip *single = new OPL::NUKED::opl3_chip();
+		OPL::NUKED::OPL3_Reset(stream, kRate);
+		OPL::NUKED::OPL3_Reset(single, kRate);
+		setupChord<OPL::NUKED::opl3_chip, writeNuked>(stream);
+		setupChord<OPL::NUKED::opl3_chip, writeNuked>(single);
+
+		int16 *streamBuffer = new int16[numSamples * 2];
+		int16 *singleBuffer = new int16[numSamples * 2];
+		for (int pos = 0; pos < numSamples; pos += 1000)
+			OPL::NUKED::OPL3_GenerateStream(stream, streamBuffer + pos * 2, MIN(1000, numSamples - pos));
+		for (int pos = 0; pos < numSamples; pos++)
+			OPL::NUKED::OPL3_GenerateResampled(single, singleBuffer + pos * 2);
+
+		TS_ASSERT_SAME_DATA(streamBuffer, singleBuffer, numSamples * 2 * sizeof(int16));
+
+		delete[] streamBuffer;
+		delete[] singleBuffer;
+		delete stream;
+		delete single;
+#endif
+	}
+
+	void test_emulator_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const int numSamples = kRate * 10;
+		const int blockSize = 1024;
+
+#ifndef DISABLE_NUKED_OPL
+		{
+			int16 buffer[blockSize * 2];
+			OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip();
+			OPL::NUKED::OPL3_Reset(chip, kRate);
+			setupChord<OPL::NUKED::opl3_chip, writeNuked>(chip);
+
+			uint32 start = g_system->getMillis();
+			for (int pos = 0; pos < numSamples; pos += blockSize)
+				OPL::NUKED::OPL3_GenerateStream(chip, buffer, blockSize);
+			uint32 time = g_system->getMillis() - start;
+			debug("Nuked OPL3: %u ms for %d samples (%f ns per sample)", time, numSamples, time * 1000000.0 / numSamples);
+
+			delete chip;
+		}
+#endif
+
+#ifndef DISABLE_DOSBOX_OPL
+		{
+			int32 buffer[blockSize * 2];
+			OPL::DOSBox::DBOPL::InitTables();
+			OPL::DOSBox::DBOPL::Chip *chip = new OPL::DOSBox::DBOPL::Chip();
+			chip->Setup(kRate);
+			setupChord<OPL::DOSBox::DBOPL::Chip, writeDOSBox>(chip);
+
+			uint32 start = g_system->getMillis();
+			for (int pos = 0; pos < numSamples; pos += blockSize)
+				chip->GenerateBlock3(blockSize, buffer);
+			uint32 time = g_system->getMillis() - start;
+			debug("DOSBox OPL3: %u ms for %d samples (%f ns per sample)", time, numSamples, time * 1000000.0 / numSamples);
+
+			delete chip;
+		}
+#endif
+#endif
+	}
+};
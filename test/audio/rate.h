@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Convert the same sine wave through the 16-bit and the float path, and
+	 * check that both agree up to the rounding of the 16-bit path.
+	 */
+	static void checkFloatPath(int inRate, int outRate, bool stereo) {
+		Audio::SeekableAudioStream *intStream = createSineStream<int16>(inRate, 1, nullptr, true, stereo);
+		Audio::SeekableAudioStream *floatStream = createSineStream<int16>(inRate, 1, nullptr, true, stereo);
+		Audio::RateConverter *intConverter = Audio::makeRateConverter(inRate, outRate, stereo, true, false);
+		Audio::RateConverter *floatConverter = Audio::makeRateConverter(inRate, outRate, stereo, true, false);
+
+		const int frames = 700;
+		int16 intOut[frames * 2];
+		float floatOut[frames * 2];
+
+		for (int pass = 0; pass < 4; pass++) {
+			memset(intOut, 0, sizeof(intOut));
+			for (int i = 0; i < frames * 2; i++)
+				floatOut[i] = 0.0f;
+
+			const int intFrames = intConverter->convert(*intStream, intOut, frames, 128, 200);
+			const int floatFrames = floatConverter->convert(*floatStream, floatOut, frames, 128, 200);
+			TS_ASSERT_EQUALS(intFrames, floatFrames);
+
+			for (int i = 0; i < intFrames * 2; i++)
+				TS_ASSERT_DELTA(floatOut[i] * 32768.0f, intOut[i], 2.0f);
+		}
+
+		delete intConverter;
+		delete floatConverter;
+		delete intStream;
+		delete floatStream;
+	}
+
+public:
+	void test_float_copy() {
+		checkFloatPath(22050, 22050, false);
+		checkFloatPath(22050, 22050, true);
+	}
+
+	void test_float_simple() {
+		checkFloatPath(44100, 22050, false);
+		checkFloatPath(44100, 22050, true);
+	}
+
+	void test_float_interpolate() {
+		checkFloatPath(11025, 44100, false);
+		checkFloatPath(22050, 48000, true);
+	}
+
+	void test_float_no_clamping() {
+		Audio::SeekableAudioStream *streams[2];
+		Audio::RateConverter *converters[2];
+		for (int i = 0; i < 2; i++) {
+			streams[i] = createSineStream<int16>(22050, 1, nullptr, true, false);
+			converters[i] = Audio::makeRateConverter(22050, 22050, false, true, false);
+		}
+
+		// Two full volume sines add up to twice the 16-bit range at their
+		// peak, a quarter second in
+		const int frames = 22050 / 2;
+		float *out = new float[frames * 2];
+		for (int i = 0; i < frames * 2; i++)
+			out[i] = 0.0f;
+
+		for (int i = 0; i < 2; i++)
+			TS_ASSERT_EQUALS(converters[i]->convert(*streams[i], out, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), frames);
+
+		float peak = 0.0f;
+		for (int i = 0; i < frames * 2; i++)
+			peak = MAX(peak, out[i]);
+		TS_ASSERT_DELTA(peak, 2.0f, 0.01f);
+		delete[] out;
+
+		for (int i = 0; i < 2; i++) {
+			delete converters[i];
+			delete streams[i];
+		}
+	}
+};
@@ -0,0 +1,108 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/mt32/BReverbModel.h"
+
+class MT32ReverbTestSuite : public CxxTest::TestSuite {
+	enum {
+		kNumSamples = 20000
+	};
+
+	static void generateInput(MT32Emu::IntSample *left, MT32Emu::IntSample *right) {
+		uint32 seed = 12345;
+		for (int i = 0; i < kNumSamples; i++) {
+			seed = seed * 1103515245 + 12345;
+			// Bursts of noise followed by silence to let the tails ring out
+			bool silent = (i / 2500) & 1;
+			left[i] = silent ? 0 : (MT32Emu::IntSample)(seed >> 16);
+			right[i] = silent ? 0 : (MT32Emu::IntSample)(seed >> 8);
+		}
+	}
+
+	static uint32 checksum(const MT32Emu::IntSample *left, const MT32Emu::IntSample *right) {
+		uint32 sum = 0;
+		for (int i = 0; i < kNumSamples; i++) {
+			sum = sum * 31 + (uint16)left[i];
+			sum = sum * 31 + (uint16)right[i];
+		}
+		return sum;
+	}
+
+	template<class Sample>
+	static void render(MT32Emu::ReverbMode mode, bool mt32Compatible, const Sample *inLeft, const Sample *inRight, Sample *outLeft, Sample *outRight, int chunkSize) {
+		const MT32Emu::RendererType type = sizeof(Sample) == sizeof(MT32Emu::IntSample) ? MT32Emu::RendererType_BIT16S : MT32Emu::RendererType_FLOAT;
+		MT32Emu::BReverbModel *model = MT32Emu::BReverbModel::createBReverbModel(mode, mt32Compatible, type);
+		model->open();
+		model->setParameters(5, 7);
+
+		for (int pos = 0; pos < kNumSamples; pos += chunkSize) {
+			int count = MIN<int>(chunkSize, kNumSamples - pos);
+			model->process(inLeft + pos, inRight + pos, outLeft + pos, outRight + pos, count);
+		}
+
+		delete model;
+	}
+
+public:
+	// Checksums of the output of the original sample by sample implementation
+	void test_golden_render() {
+		static const uint32 expected[2][4] = {
+			{ 4271615384u, 4246893139u, 1777319298u, 110731881u },
+			{ 3151624718u, 1411803061u, 2339029143u, 1631954484u }
+		};
+
+		MT32Emu::IntSample *inLeft = new MT32Emu::IntSample[kNumSamples];
+		MT32Emu::IntSample *inRight = new MT32Emu::IntSample[kNumSamples];
+		MT32Emu::IntSample *outLeft = new MT32Emu::IntSample[kNumSamples];
+		MT32Emu::IntSample *outRight = new MT32Emu::IntSample[kNumSamples];
+		generateInput(inLeft, inRight);
+
+		for (int compatible = 0; compatible < 2; compatible++) {
+			for (int mode = 0; mode < 4; mode++) {
+				render(MT32Emu::ReverbMode(mode), compatible != 0, inLeft, inRight, outLeft, outRight, kNumSamples);
+				TS_ASSERT_EQUALS(checksum(outLeft, outRight), expected[compatible][mode]);
+				render(MT32Emu::ReverbMode(mode), compatible != 0, inLeft, inRight, outLeft, outRight, 77);
+				TS_ASSERT_EQUALS(checksum(outLeft, outRight), expected[compatible][mode]);
+			}
+		}
+
+		delete[] inLeft;
+		delete[] inRight;
+		delete[] outLeft;
+		delete[] outRight;
+	}
+
+	// The output must not depend on how the input is split into calls
+	void test_chunk_independence() {
+		float *inLeft = new float[kNumSamples];
+		float *inRight = new float[kNumSamples];
+		float *outLeft[2], *outRight[2];
+		MT32Emu::IntSample *intLeft = new MT32Emu::IntSample[kNumSamples];
+		MT32Emu::IntSample *intRight = new MT32Emu::IntSample[kNumSamples];
+		generateInput(intLeft, intRight);
+		for (int i = 0; i < kNumSamples; i++) {
+			inLeft[i] = intLeft[i] / 32768.0f;
+			inRight[i] = intRight[i] / 32768.0f;
+		}
+
+		for (int i = 0; i < 2; i++) {
+			outLeft[i] = new float[kNumSamples];
+			outRight[i] = new float[kNumSamples];
+		}
+
+		for (int mode = 0; mode < 4; mode++) {
+			render(MT32Emu::ReverbMode(mode), false, inLeft, inRight, outLeft[0], outRight[0], kNumSamples);
+			render(MT32Emu::ReverbMode(mode), false, inLeft, inRight, outLeft[1], outRight[1], 77);
+			TS_ASSERT_SAME_DATA(outLeft[0], outLeft[1], kNumSamples * sizeof(float));
+			TS_ASSERT_SAME_DATA(outRight[0], outRight[1], kNumSamples * sizeof(float));
+		}
+
+		for (int i = 0; i < 2; i++) {
+			delete[] outLeft[i];
+			delete[] outRight[i];
+		}
+		delete[] inLeft;
+		delete[] inRight;
+		delete[] intLeft;
+		delete[] intRight;
+	}
+};
@@ -0,0 +1,118 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/soundcache.h"
+#include "audio/audiostream.h"
+
+#include "helper.h"
+#include "../null_osystem.h"
+
+class SoundCacheTestSuite : public CxxTest::TestSuite {
+	static void checkStream(Audio::SeekableAudioStream *s, const int16 *expected, int samples, int rate, bool stereo) {
+		TS_ASSERT(s);
+		TS_ASSERT_EQUALS(s->getRate(), rate);
+		TS_ASSERT_EQUALS(s->isStereo(), stereo);
+
+		int16 *buffer = new int16[samples];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, samples), samples);
+		TS_ASSERT_EQUALS(memcmp(expected, buffer, sizeof(int16) * samples), 0);
+		TS_ASSERT(s->endOfData());
+		delete[] buffer;
+	}
+
+public:
+	void test_decode_once() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::SoundCache cache(1024 * 1024);
+		TS_ASSERT(!cache.makeStream("sfx:1"));
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		int16 *sine;
+		const int samples = 11025 * 2 * 2;
+		Audio::SeekableAudioStream *s = cache.insert("sfx:1", createSineStream<uint8>(11025, 2, &sine, false, true));
+		TS_ASSERT_EQUALS(cache.getUsedBytes(), (uint32)samples * 2);
+		checkStream(s, sine, samples, 11025, true);
+
+		// Replaying and rewinding works from the cached PCM data
+		TS_ASSERT(s->rewind());
+		checkStream(s, sine, samples, 11025, true);
+		delete s;
+
+		s = cache.makeStream("sfx:1");
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+		checkStream(s, sine, samples, 11025, true);
+
+		// Streams stay valid after the cache is gone
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+		TS_ASSERT(s->rewind());
+		checkStream(s, sine, samples, 11025, true);
+
+		delete s;
+		delete[] sine;
+#endif
+	}
+
+	void test_insert_data() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::SoundCache cache(1024 * 1024);
+
+		const int samples = 1000;
+		int16 *data = (int16 *)malloc(samples * sizeof(int16));
+		for (int i = 0; i < samples; ++i)
+			data[i] = i * 16;
+
+		// The cache takes over the data instead of copying it
+		Audio::SeekableAudioStream *s = cache.insert("music:1", data, samples * sizeof(int16), 22050, false);
+		TS_ASSERT_EQUALS(cache.getUsedBytes(), (uint32)samples * 2);
+		TS_ASSERT_EQUALS(s->getRate(), 22050);
+		TS_ASSERT(!s->isStereo());
+
+		int16 buffer[samples];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, samples), samples);
+		TS_ASSERT_EQUALS(buffer[0], 0);
+		TS_ASSERT_EQUALS(buffer[samples - 1], (samples - 1) * 16);
+		TS_ASSERT(s->endOfData());
+		delete s;
+
+		s = cache.makeStream("music:1");
+		TS_ASSERT(s);
+		delete s;
+#endif
+	}
+
+	void test_lru_eviction() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Room for two one second mono sounds
+		Audio::SoundCache cache(2 * 1000 * 2);
+
+		delete cache.insert("a", createSineStream<int16>(1000, 1, nullptr, true, false));
+		delete cache.insert("b", createSineStream<int16>(1000, 1, nullptr, true, false));
+		TS_ASSERT_EQUALS(cache.getCount(), 2u);
+
+		// Touch "a", so "b" becomes the least recently used sound
+		delete cache.makeStream("a");
+
+		delete cache.insert("c", createSineStream<int16>(1000, 1, nullptr, true, false));
+		TS_ASSERT_EQUALS(cache.getCount(), 2u);
+		TS_ASSERT_EQUALS(cache.getEvictions(), 1u);
+		TS_ASSERT(!cache.makeStream("b"));
+
+		// A sound which is still playing is never evicted
+		Audio::SeekableAudioStream *playing = cache.makeStream("a");
+		TS_ASSERT(playing);
+		cache.setMaxBytes(0);
+		TS_ASSERT_EQUALS(cache.getCount(), 1u);
+
+		delete playing;
+		cache.setMaxBytes(0);
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+		TS_ASSERT_EQUALS(cache.getUsedBytes(), 0u);
+#endif
+	}
+};
@@ -0,0 +1,84 @@
+#include <cxxtest/TestSuite.h>
+
+#include "image/image_cache.h"
+#include "graphics/surface.h"
+
+class ImageCacheTestSuite : public CxxTest::TestSuite {
+	static Graphics::Surface *createSurface(int w, int h, const Graphics::PixelFormat &format) {
+		Graphics::Surface *surface = new Graphics::Surface();
+		surface->create(w, h, format);
+		return surface;
+	}
+
+public:
+	void test_lookup() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat rgba(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Image::ImageCache cache(1024 * 1024);
+
+		TS_ASSERT(!cache.get("dir/image.png", rgb565));
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		Graphics::Surface *surface = createSurface(8, 8, rgb565);
+		cache.insert("dir/image.png", surface, 0, Graphics::ALPHA_BINARY);
+		TS_ASSERT_EQUALS(cache.getUsedBytes(), 8u * 8u * 2u);
+
+		Graphics::AlphaType alphaType = Graphics::ALPHA_FULL;
+		TS_ASSERT_EQUALS(cache.get("dir/image.png", rgb565, 0, &alphaType).get(), surface);
+		TS_ASSERT_EQUALS(alphaType, Graphics::ALPHA_BINARY);
+
+		TS_ASSERT_EQUALS(cache.get("dir/image.png", rgb565).get(), surface);
+		TS_ASSERT_EQUALS(cache.get("DIR/Image.PNG", rgb565).get(), surface);
+		TS_ASSERT_EQUALS(cache.getHits(), 3u);
+
+		// The format and the variant are part of the key
+		TS_ASSERT(!cache.get("dir/image.png", rgba));
+		TS_ASSERT(!cache.get("dir/image.png", rgb565, 1));
+		TS_ASSERT_EQUALS(cache.getMisses(), 3u);
+
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+		TS_ASSERT_EQUALS(cache.getUsedBytes(), 0u);
+	}
+
+	void test_lru_eviction() {
+		const Graphics::PixelFormat clut8 = Graphics::PixelFormat::createFormatCLUT8();
+		Image::ImageCache cache(300);
+
+		cache.insert("a", createSurface(10, 10, clut8));
+		cache.insert("b", createSurface(10, 10, clut8));
+		cache.insert("c", createSurface(10, 10, clut8));
+		TS_ASSERT_EQUALS(cache.getCount(), 3u);
+
+		// Touch "a", so "b" becomes the least recently used image
+		TS_ASSERT(cache.get("a", clut8));
+
+		cache.insert("d", createSurface(10, 10, clut8));
+		TS_ASSERT_EQUALS(cache.getCount(), 3u);
+		TS_ASSERT_EQUALS(cache.getEvictions(), 1u);
+		TS_ASSERT(!cache.get("b", clut8));
+		TS_ASSERT(cache.get("a", clut8));
+		TS_ASSERT(cache.get("c", clut8));
+		TS_ASSERT(cache.get("d", clut8));
+	}
+
+	void test_referenced_images_stay() {
+		const Graphics::PixelFormat clut8 = Graphics::PixelFormat::createFormatCLUT8();
+		Image::ImageCache cache(150);
+
+		Image::ImageCache::SurfacePtr held = cache.insert("a", createSurface(10, 10, clut8));
+		cache.insert("b", createSurface(10, 10, clut8));
+		cache.insert("c", createSurface(10, 10, clut8));
+
+		// "a" is the least recently used image, but it's still referenced
+		TS_ASSERT_EQUALS(cache.getCount(), 2u);
+		TS_ASSERT_EQUALS(cache.getEvictions(), 1u);
+		TS_ASSERT(cache.get("a", clut8));
+		TS_ASSERT(!cache.get("b", clut8));
+		TS_ASSERT(cache.get("c", clut8));
+
+		held.reset();
+		cache.setMaxBytes(0);
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+	}
+};
@@ -0,0 +1,59 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_output_pixel_format() {
+#ifdef USE_PNG
+		const Graphics::PixelFormat rgba(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+
+		Graphics::Surface input;
+		input.create(7, 5, rgba);
+		for (int y = 0; y < input.h; y++)
+			for (int x = 0; x < input.w; x++)
+				input.setPixel(x, y, rgba.ARGBToColor(255 - x * 16, x * 37, y * 51, (x + y) * 23));
+
+		Common::MemoryWriteStreamDynamic png(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writePNG(png, input));
+		input.free();
+
+		Image::PNGDecoder plainDecoder;
+		Common::MemoryReadStream plainStream(png.getData(), png.size());
+		TS_ASSERT(plainDecoder.loadStream(plainStream));
+		Graphics::Surface *expected = plainDecoder.getSurface()->convertTo(rgb565);
+
+		Image::PNGDecoder decoder;
+		decoder.setOutputPixelFormat(rgb565);
+		Common::MemoryReadStream stream(png.getData(), png.size());
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->format, rgb565);
+		// The source alpha channel is still reported, even if the output format has none
+		TS_ASSERT(decoder.hasAlpha());
+		TS_ASSERT_EQUALS(surface->w, expected->w);
+		TS_ASSERT_EQUALS(surface->h, expected->h);
+		for (int y = 0; y < expected->h; y++)
+			for (int x = 0; x < expected->w; x++)
+				TS_ASSERT_EQUALS(surface->getPixel(x, y), expected->getPixel(x, y));
+
+		// The caller can take over the surface instead of copying it
+		Graphics::Surface *released = decoder.releaseSurface();
+		TS_ASSERT_EQUALS(released, surface);
+		TS_ASSERT(!decoder.getSurface());
+		released->free();
+		delete released;
+
+		expected->free();
+		delete expected;
+#endif
+	}
+};
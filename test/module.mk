@@ -30,6 +30,11 @@ endif
 
 TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
+ifdef USE_MT32EMU
+	TESTS += $(srcdir)/test/audio/softsynth/*.h
+	TEST_LIBS += audio/softsynth/mt32/libmt32.a
+endif
+
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
 	TEST_LIBS += engines/wintermute/libwintermute.a
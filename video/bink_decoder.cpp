@@ -305,6 +305,10 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32
 	memset(_curPlanes[3], 255, _yBlockWidth  * 8 * _yBlockHeight  * 8);
 	memset(_oldPlanes[3], 255, _yBlockWidth  * 8 * _yBlockHeight  * 8);
 
+	// The plane pitches never change, so the block coordinates only need calculating once
+	initCoordMaps(_coordMaps[0], _yBlockWidth  * 8);
+	initCoordMaps(_coordMaps[1], _uvBlockWidth * 8);
+
 	initBundles();
 	initHuffman();
 }
@@ -469,6 +473,8 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	if (_id == kBIKiID)
 		frame.bits->skip(32);
 
+	// The planes have to be decoded in order: they are read from the same
+	// bitstream, and they share the bundles and the color Huffman state.
 	for (int i = 0; i < 3; i++) {
 		int planeIdx = ((i == 0) || !_swapPlanes) ? i : (i ^ 3);
 
@@ -481,7 +487,9 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
-	if (_hasAlpha) {
+	// The alpha plane still has to be decoded to keep the bitstream in sync,
+	// but there's no point in merging it into an output format without alpha.
+	if (_hasAlpha && _pixelFormat.aBits() != 0) {
 		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
 		YUVToRGBMan.convert420Alpha(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
 				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
@@ -514,14 +522,13 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 	ctx.prevEnd   = _oldPlanes[planeIdx] + width * height;
 	ctx.pitch     = width;
 
-	for (int i = 0; i < 64; i++) {
-		ctx.coordMap[i] = (i & 7) + (i >> 3) * ctx.pitch;
+	const CoordMaps &maps = _coordMaps[isChroma ? 1 : 0];
 
-		ctx.coordScaledMap1[i] = ((i & 7) * 2 + 0) + (((i >> 3) * 2 + 0) * ctx.pitch);
-		ctx.coordScaledMap2[i] = ((i & 7) * 2 + 1) + (((i >> 3) * 2 + 0) * ctx.pitch);
-		ctx.coordScaledMap3[i] = ((i & 7) * 2 + 0) + (((i >> 3) * 2 + 1) * ctx.pitch);
-		ctx.coordScaledMap4[i] = ((i & 7) * 2 + 1) + (((i >> 3) * 2 + 1) * ctx.pitch);
-	}
+	ctx.coordMap        = maps.coordMap;
+	ctx.coordScaledMap1 = maps.coordScaledMap1;
+	ctx.coordScaledMap2 = maps.coordScaledMap2;
+	ctx.coordScaledMap3 = maps.coordScaledMap3;
+	ctx.coordScaledMap4 = maps.coordScaledMap4;
 
 	for (int i = 0; i < kSourceMAX; i++) {
 		_bundles[i].countLength = _bundles[i].countLengths[isChroma ? 1 : 0];
@@ -598,6 +605,17 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 }
 
+void BinkDecoder::BinkVideoTrack::initCoordMaps(CoordMaps &maps, uint32 pitch) {
+	for (int i = 0; i < 64; i++) {
+		maps.coordMap[i] = (i & 7) + (i >> 3) * pitch;
+
+		maps.coordScaledMap1[i] = ((i & 7) * 2 + 0) + (((i >> 3) * 2 + 0) * pitch);
+		maps.coordScaledMap2[i] = ((i & 7) * 2 + 1) + (((i >> 3) * 2 + 0) * pitch);
+		maps.coordScaledMap3[i] = ((i & 7) * 2 + 0) + (((i >> 3) * 2 + 1) * pitch);
+		maps.coordScaledMap4[i] = ((i & 7) * 2 + 1) + (((i >> 3) * 2 + 1) * pitch);
+	}
+}
+
 void BinkDecoder::BinkVideoTrack::readBundle(VideoFrame &video, Source source) {
 	if (source == kSourceColors) {
 		for (int i = 0; i < 16; i++)
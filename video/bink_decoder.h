@@ -185,6 +185,15 @@ private:
 
 			uint32 pitch;
 
+			const int *coordMap;
+			const int *coordScaledMap1;
+			const int *coordScaledMap2;
+			const int *coordScaledMap3;
+			const int *coordScaledMap4;
+		};
+
+		/** Pixel offsets of the 64 positions within a block, for a given plane pitch. */
+		struct CoordMaps {
 			int coordMap[64];
 			int coordScaledMap1[64];
 			int coordScaledMap2[64];
@@ -275,6 +284,8 @@ private:
 		byte *_curPlanes[4]; ///< The 4 color planes, YUVA, current frame.
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
+		CoordMaps _coordMaps[2]; ///< Block coordinate maps for the luma/alpha and the chroma planes.
+
 		/** Initialize the bundles. */
 		void initBundles();
 		/** Deinitialize the bundles. */
@@ -283,6 +294,9 @@ private:
 		/** Initialize the Huffman decoders. */
 		void initHuffman();
 
+		/** Initialize the block coordinate maps for a plane pitch. */
+		static void initCoordMaps(CoordMaps &maps, uint32 pitch);
+
 		/** Decode a plane. */
 		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
 